@@ -26,8 +26,9 @@ void UAsyncAction_ListenForFactChanges::Activate()
 	if ( UWorld* World = WorldPtr.Get() )
 	{
 		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
-		FactSubsystem.GetOnFactValueChangedDelegate( Tag ).AddUObject( this, &ThisClass::HandleFactValueChanged );
-		FactSubsystem.GetOnFactBecameDefinedDelegate( Tag ).AddUObject( this, &ThisClass::HandleFactBecameDefined );
+		ValueListenerHandle = FactSubsystem.AddFactValueListener( Tag, FFactChanged::FDelegate::CreateUObject( this, &ThisClass::HandleFactValueChanged ) );
+		DefinitionListenerHandle = FactSubsystem.AddFactDefinitionListener( Tag, FFactChanged::FDelegate::CreateUObject( this, &ThisClass::HandleFactBecameDefined ) );
+		UndefinitionListenerHandle = FactSubsystem.AddFactUndefinitionListener( Tag, FFactChanged::FDelegate::CreateUObject( this, &ThisClass::HandleFactBecameUndefined ) );
 		return;
 	}
 
@@ -39,8 +40,9 @@ void UAsyncAction_ListenForFactChanges::SetReadyToDestroy()
 	if ( UWorld* World = WorldPtr.Get() )
 	{
 		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
-		FactSubsystem.GetOnFactValueChangedDelegate( Tag ).RemoveAll( this );
-		FactSubsystem.GetOnFactBecameDefinedDelegate( Tag ).RemoveAll( this );
+		FactSubsystem.RemoveFactListener( ValueListenerHandle );
+		FactSubsystem.RemoveFactListener( DefinitionListenerHandle );
+		FactSubsystem.RemoveFactListener( UndefinitionListenerHandle );
 	}
 	
 	Super::SetReadyToDestroy();
@@ -48,7 +50,7 @@ void UAsyncAction_ListenForFactChanges::SetReadyToDestroy()
 
 void UAsyncAction_ListenForFactChanges::HandleFactValueChanged( int32 CurrentValue )
 {
-	if ( OnFactValueChanged.IsBound() == false && OnFactBecameDefined.IsBound() == false )
+	if ( IsAnyDelegateBound() == false )
 	{
 		SetReadyToDestroy();
 		return;
@@ -59,7 +61,7 @@ void UAsyncAction_ListenForFactChanges::HandleFactValueChanged( int32 CurrentVal
 
 void UAsyncAction_ListenForFactChanges::HandleFactBecameDefined( int32 CurrentValue )
 {
-	if ( OnFactValueChanged.IsBound() == false && OnFactBecameDefined.IsBound() == false )
+	if ( IsAnyDelegateBound() == false )
 	{
 		SetReadyToDestroy();
 		return;
@@ -67,3 +69,19 @@ void UAsyncAction_ListenForFactChanges::HandleFactBecameDefined( int32 CurrentVa
 	
 	OnFactBecameDefined.Broadcast( CurrentValue );
 }
+
+void UAsyncAction_ListenForFactChanges::HandleFactBecameUndefined( int32 CurrentValue )
+{
+	if ( IsAnyDelegateBound() == false )
+	{
+		SetReadyToDestroy();
+		return;
+	}
+	
+	OnFactBecameUndefined.Broadcast( CurrentValue );
+}
+
+bool UAsyncAction_ListenForFactChanges::IsAnyDelegateBound() const
+{
+	return OnFactValueChanged.IsBound() || OnFactBecameDefined.IsBound() || OnFactBecameUndefined.IsBound();
+}
@@ -0,0 +1,56 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "AsyncAction_ListenForFactSubtreeChanges.h"
+
+#include "FactSubsystem.h"
+#include "Engine/Engine.h"
+
+UAsyncAction_ListenForFactSubtreeChanges* UAsyncAction_ListenForFactSubtreeChanges::ListenForFactSubtreeChanges( UObject* WorldContextObject, FFactTag ParentTag )
+{
+	UWorld* World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::LogAndReturnNull );
+	if ( World == nullptr )
+	{
+		return nullptr;
+	}
+
+	UAsyncAction_ListenForFactSubtreeChanges* Action = NewObject< UAsyncAction_ListenForFactSubtreeChanges >();
+	Action->WorldPtr = World;
+	Action->ParentTag = ParentTag;
+	Action->RegisterWithGameInstance( World );
+
+	return Action;
+}
+
+void UAsyncAction_ListenForFactSubtreeChanges::Activate()
+{
+	if ( UWorld* World = WorldPtr.Get() )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
+		ListenerHandle = FactSubsystem.AddFactSubtreeListener( ParentTag, FFactSubtreeChanged::FDelegate::CreateUObject( this, &ThisClass::HandleFactValueChanged ) );
+		return;
+	}
+
+	SetReadyToDestroy();
+}
+
+void UAsyncAction_ListenForFactSubtreeChanges::SetReadyToDestroy()
+{
+	if ( UWorld* World = WorldPtr.Get() )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
+		FactSubsystem.RemoveFactListener( ListenerHandle );
+	}
+	
+	Super::SetReadyToDestroy();
+}
+
+void UAsyncAction_ListenForFactSubtreeChanges::HandleFactValueChanged( FFactTag ChangedTag, int32 CurrentValue )
+{
+	if ( OnFactValueChanged.IsBound() == false )
+	{
+		SetReadyToDestroy();
+		return;
+	}
+	
+	OnFactValueChanged.Broadcast( ChangedTag, CurrentValue );
+}
@@ -0,0 +1,44 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "AsyncAction_LoadFacts.h"
+
+#include "FactSubsystem.h"
+#include "Engine/Engine.h"
+
+UAsyncAction_LoadFacts* UAsyncAction_LoadFacts::LoadFactsAsync( UObject* WorldContextObject, const UFactSaveGame* SaveGame )
+{
+	UWorld* World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::LogAndReturnNull );
+	if ( World == nullptr )
+	{
+		return nullptr;
+	}
+
+	UAsyncAction_LoadFacts* Action = NewObject< UAsyncAction_LoadFacts >();
+	Action->WorldPtr = World;
+	Action->SaveGame = SaveGame;
+	Action->RegisterWithGameInstance( World );
+
+	return Action;
+}
+
+void UAsyncAction_LoadFacts::Activate()
+{
+	if ( UWorld* World = WorldPtr.Get() )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
+		FactSubsystem.OnGameLoadedAsync( SaveGame, FFactLoadCompleted::CreateUObject( this, &ThisClass::HandleCompleted ) );
+		return;
+	}
+
+	SetReadyToDestroy();
+}
+
+void UAsyncAction_LoadFacts::HandleCompleted( bool bSuccess )
+{
+	if ( ShouldBroadcastDelegates() )
+	{
+		OnCompleted.Broadcast( bSuccess );
+	}
+
+	SetReadyToDestroy();
+}
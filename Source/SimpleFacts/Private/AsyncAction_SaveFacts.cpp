@@ -0,0 +1,44 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "AsyncAction_SaveFacts.h"
+
+#include "FactSubsystem.h"
+#include "Engine/Engine.h"
+
+UAsyncAction_SaveFacts* UAsyncAction_SaveFacts::SaveFactsAsync( UObject* WorldContextObject, UFactSaveGame* SaveGame )
+{
+	UWorld* World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::LogAndReturnNull );
+	if ( World == nullptr )
+	{
+		return nullptr;
+	}
+
+	UAsyncAction_SaveFacts* Action = NewObject< UAsyncAction_SaveFacts >();
+	Action->WorldPtr = World;
+	Action->SaveGame = SaveGame;
+	Action->RegisterWithGameInstance( World );
+
+	return Action;
+}
+
+void UAsyncAction_SaveFacts::Activate()
+{
+	if ( UWorld* World = WorldPtr.Get() )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
+		FactSubsystem.OnGameSavedAsync( SaveGame, FFactSaveCompleted::CreateUObject( this, &ThisClass::HandleCompleted ) );
+		return;
+	}
+
+	SetReadyToDestroy();
+}
+
+void UAsyncAction_SaveFacts::HandleCompleted( bool bSuccess )
+{
+	if ( ShouldBroadcastDelegates() )
+	{
+		OnCompleted.Broadcast( bSuccess );
+	}
+
+	SetReadyToDestroy();
+}
@@ -0,0 +1,60 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "AsyncAction_WatchFactExpression.h"
+
+#include "FactSubsystem.h"
+#include "Engine/Engine.h"
+
+UAsyncAction_WatchFactExpression* UAsyncAction_WatchFactExpression::WatchFactExpression( UObject* WorldContextObject, const FFactExpression& Expression )
+{
+	UWorld* World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::LogAndReturnNull );
+	if ( World == nullptr )
+	{
+		return nullptr;
+	}
+
+	UAsyncAction_WatchFactExpression* Action = NewObject< UAsyncAction_WatchFactExpression >();
+	Action->WorldPtr = World;
+	Action->Expression = Expression;
+	Action->RegisterWithGameInstance( World );
+
+	return Action;
+}
+
+void UAsyncAction_WatchFactExpression::Activate()
+{
+	if ( UWorld* World = WorldPtr.Get() )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
+		WatcherHandle = FactSubsystem.AddFactConditionWatcher( Expression, FFactConditionResultChanged::FDelegate::CreateUObject( this, &ThisClass::HandleResultChanged ) );
+		if ( WatcherHandle.IsValid() )
+		{
+			OnInitialResult.Broadcast( FactSubsystem.GetFactConditionWatcherResult( WatcherHandle ) );
+			return;
+		}
+	}
+
+	SetReadyToDestroy();
+}
+
+void UAsyncAction_WatchFactExpression::SetReadyToDestroy()
+{
+	if ( UWorld* World = WorldPtr.Get() )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
+		FactSubsystem.RemoveFactConditionWatcher( WatcherHandle );
+	}
+	
+	Super::SetReadyToDestroy();
+}
+
+void UAsyncAction_WatchFactExpression::HandleResultChanged( bool bPasses )
+{
+	if ( OnResultChanged.IsBound() == false )
+	{
+		SetReadyToDestroy();
+		return;
+	}
+	
+	OnResultChanged.Broadcast( bPasses );
+}
@@ -0,0 +1,103 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactAggregates.h"
+
+#include "FactTagIndex.h"
+
+void FFactAggregates::Rebuild( const FFactStorage& Storage )
+{
+	Nodes.Reset();
+	Nodes.SetNum( FFactTagIndex::Get().Num() );
+
+	Storage.ForEachDefined( [ this ]( int32 Index, int32 Value )
+	{
+		OnFactChanged( Index, nullptr, &Value );
+	} );
+}
+
+void FFactAggregates::OnFactChanged( int32 Index, const int32* OldValue, const int32* NewValue )
+{
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+	if ( Index >= Nodes.Num() )
+	{
+		Nodes.SetNum( TagIndex.Num() );
+	}
+
+	const int32 CountDelta = ( NewValue != nullptr ? 1 : 0 ) - ( OldValue != nullptr ? 1 : 0 );
+	const int64 SumDelta = static_cast< int64 >( NewValue != nullptr ? *NewValue : 0 ) - ( OldValue != nullptr ? *OldValue : 0 );
+
+	for ( int32 NodeIndex = Index; NodeIndex != INDEX_NONE; NodeIndex = TagIndex.GetParent( NodeIndex ) )
+	{
+		FNode& Node = Nodes[ NodeIndex ];
+		FFactAggregate& Aggregate = Node.Aggregate;
+
+		const int32 PreviousCount = Aggregate.DefinedCount;
+		Aggregate.DefinedCount += CountDelta;
+		Aggregate.Sum += SumDelta;
+
+		if ( Aggregate.DefinedCount == 0 )
+		{
+			Node = FNode();
+			continue;
+		}
+
+		if ( PreviousCount == 0 )
+		{
+			// NewValue is the only defined value in subtree
+			Aggregate.Min = Aggregate.Max = *NewValue;
+			Node.bMinStale = Node.bMaxStale = false;
+			continue;
+		}
+
+		// old value could be the only extreme, then real one is unknown until subtree is scanned
+		if ( OldValue != nullptr )
+		{
+			Node.bMinStale |= *OldValue == Aggregate.Min && ( NewValue == nullptr || *NewValue > *OldValue );
+			Node.bMaxStale |= *OldValue == Aggregate.Max && ( NewValue == nullptr || *NewValue < *OldValue );
+		}
+
+		// even stale extreme is still a bound of real one, so new value beyond it is exact extreme
+		if ( NewValue != nullptr )
+		{
+			if ( *NewValue <= Aggregate.Min )
+			{
+				Aggregate.Min = *NewValue;
+				Node.bMinStale = false;
+			}
+			if ( *NewValue >= Aggregate.Max )
+			{
+				Aggregate.Max = *NewValue;
+				Node.bMaxStale = false;
+			}
+		}
+	}
+}
+
+FFactAggregate FFactAggregates::Get( int32 Index, const FFactStorage& Storage ) const
+{
+	if ( Nodes.IsValidIndex( Index ) == false )
+	{
+		return {};
+	}
+
+	FNode& Node = Nodes[ Index ];
+	if ( Node.bMinStale || Node.bMaxStale )
+	{
+		int32 Min = MAX_int32;
+		int32 Max = MIN_int32;
+		for ( const int32 SubtreeIndex : FFactTagIndex::Get().GetSubtree( Index ) )
+		{
+			if ( const int32* Value = Storage.Find( SubtreeIndex ) )
+			{
+				Min = FMath::Min( Min, *Value );
+				Max = FMath::Max( Max, *Value );
+			}
+		}
+
+		Node.Aggregate.Min = Min;
+		Node.Aggregate.Max = Max;
+		Node.bMinStale = Node.bMaxStale = false;
+	}
+
+	return Node.Aggregate;
+}
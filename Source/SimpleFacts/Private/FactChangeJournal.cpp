@@ -0,0 +1,61 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactChangeJournal.h"
+
+void FFactChangeJournal::Reset( int32 InCapacity )
+{
+	Capacity = FMath::Max( InCapacity, 0 );
+	Records.Reset();
+	Records.SetNum( Capacity * 2 );
+	FirstSequence = NextSequence;
+}
+
+void FFactChangeJournal::Record( const FFactTag Tag, int32 OldValue, int32 NewValue )
+{
+	if ( Capacity == 0 )
+	{
+		return;
+	}
+
+	const uint64 Sequence = NextSequence++;
+	const int32 Position = static_cast< int32 >( Sequence % Capacity );
+
+	FFactChangeRecord& ChangeRecord = Records[ Position ];
+	ChangeRecord.Sequence = Sequence;
+	ChangeRecord.Tag = Tag;
+	ChangeRecord.OldValue = OldValue;
+	ChangeRecord.NewValue = NewValue;
+	ChangeRecord.Timestamp = FPlatformTime::Seconds();
+	Records[ Position + Capacity ] = ChangeRecord;
+
+	if ( NextSequence - FirstSequence > static_cast< uint64 >( Capacity ) )
+	{
+		FirstSequence = NextSequence - Capacity;
+	}
+}
+
+TConstArrayView< FFactChangeRecord > FFactChangeJournal::GetChangesSince( uint64 Sequence, bool& bOutOverflowed ) const
+{
+	bOutOverflowed = false;
+	if ( Sequence >= GetLatestSequence() )
+	{
+		return {};
+	}
+
+	uint64 WantedSequence = Sequence + 1;
+	if ( WantedSequence < FirstSequence )
+	{
+		bOutOverflowed = true;
+		WantedSequence = FirstSequence;
+	}
+
+	const int32 Num = static_cast< int32 >( NextSequence - WantedSequence );
+	if ( Num == 0 )
+	{
+		return {};
+	}
+
+	// records are mirrored, so range never wraps around
+	const int32 Start = static_cast< int32 >( WantedSequence % Capacity );
+	return MakeArrayView( Records.GetData() + Start, Num );
+}
@@ -0,0 +1,158 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactConditionBatch.h"
+
+#include "FactLogChannels.h"
+#include "FactStorage.h"
+#include "FactTypes.h"
+
+namespace FactConditionBatch
+{
+	static constexpr int32 NumOperators = static_cast< int32 >( EFactCompareOperator::IsDefined ) + 1;
+
+	// Structure of arrays for single operator group, so it can be loaded directly into vector registers
+	struct FGroup
+	{
+		TArray< int32 > ConditionIndices;
+		TArray< int32 > Values;
+		TArray< int32 > WantedValues;
+		TArray< int32 > DefinedMasks; // ~0 if fact is defined, 0 otherwise
+	};
+
+	[[nodiscard]] constexpr bool IsDefinitionCheck( EFactCompareOperator Operator )
+	{
+		return Operator == EFactCompareOperator::IsDefined || Operator == EFactCompareOperator::IsUndefined;
+	}
+
+	template< EFactCompareOperator Operator >
+	FORCEINLINE VectorRegister4Int Compare( const VectorRegister4Int& Values, const VectorRegister4Int& WantedValues )
+	{
+		if constexpr ( Operator == EFactCompareOperator::Equals )
+		{
+			return VectorIntCompareEQ( Values, WantedValues );
+		}
+		else if constexpr ( Operator == EFactCompareOperator::NotEquals )
+		{
+			return VectorIntCompareNEQ( Values, WantedValues );
+		}
+		else if constexpr ( Operator == EFactCompareOperator::Greater )
+		{
+			return VectorIntCompareGT( Values, WantedValues );
+		}
+		else if constexpr ( Operator == EFactCompareOperator::GreaterOrEqual )
+		{
+			return VectorIntCompareGE( Values, WantedValues );
+		}
+		else if constexpr ( Operator == EFactCompareOperator::Less )
+		{
+			return VectorIntCompareLT( Values, WantedValues );
+		}
+		else
+		{
+			static_assert( Operator == EFactCompareOperator::LessOrEqual, "Only value comparisons can be vectorized" );
+			return VectorIntCompareLE( Values, WantedValues );
+		}
+	}
+
+	template< EFactCompareOperator Operator >
+	void EvaluateGroup( const FGroup& Group, TBitArray<>& OutResults )
+	{
+		const int32 Num = Group.ConditionIndices.Num();
+		const int32 NumVectorized = Num & ~3;
+
+		for ( int32 Index = 0; Index < NumVectorized; Index += 4 )
+		{
+			const VectorRegister4Int Values = VectorIntLoad( &Group.Values[ Index ] );
+			const VectorRegister4Int WantedValues = VectorIntLoad( &Group.WantedValues[ Index ] );
+			const VectorRegister4Int DefinedMasks = VectorIntLoad( &Group.DefinedMasks[ Index ] );
+
+			// undefined facts never pass value comparisons
+			const VectorRegister4Int Results = VectorIntAnd( Compare< Operator >( Values, WantedValues ), DefinedMasks );
+			const uint32 ResultBits = VectorMaskBits( VectorCastIntToFloat( Results ) );
+
+			OutResults[ Group.ConditionIndices[ Index ] ] = ( ResultBits & 1 ) != 0;
+			OutResults[ Group.ConditionIndices[ Index + 1 ] ] = ( ResultBits & 2 ) != 0;
+			OutResults[ Group.ConditionIndices[ Index + 2 ] ] = ( ResultBits & 4 ) != 0;
+			OutResults[ Group.ConditionIndices[ Index + 3 ] ] = ( ResultBits & 8 ) != 0;
+		}
+
+		for ( int32 Index = NumVectorized; Index < Num; ++Index )
+		{
+			const int32* Value = Group.DefinedMasks[ Index ] ? &Group.Values[ Index ] : nullptr;
+			OutResults[ Group.ConditionIndices[ Index ] ] = FFactCondition::Compare( Value, Operator, Group.WantedValues[ Index ] );
+		}
+	}
+
+	void Evaluate( const FFactStorage& Storage, TArrayView< const FFactCondition > Conditions, TBitArray<>& OutResults )
+	{
+		OutResults.Init( false, Conditions.Num() );
+
+		// count conditions per operator first, so groups are allocated only once
+		int32 GroupSizes[ NumOperators ] = {};
+		for ( const FFactCondition& Condition : Conditions )
+		{
+			++GroupSizes[ static_cast< int32 >( Condition.Operator ) ];
+		}
+
+		FGroup Groups[ NumOperators ];
+		for ( int32 Operator = 0; Operator < NumOperators; ++Operator )
+		{
+			Groups[ Operator ].ConditionIndices.Reserve( GroupSizes[ Operator ] );
+			Groups[ Operator ].DefinedMasks.Reserve( GroupSizes[ Operator ] );
+
+			// definition checks read only defined masks
+			if ( IsDefinitionCheck( static_cast< EFactCompareOperator >( Operator ) ) == false )
+			{
+				Groups[ Operator ].Values.Reserve( GroupSizes[ Operator ] );
+				Groups[ Operator ].WantedValues.Reserve( GroupSizes[ Operator ] );
+			}
+		}
+
+		// gather values from dense storage
+		const TConstArrayView< int32 > StorageValues = Storage.GetValues();
+		for ( int32 ConditionIndex = 0; ConditionIndex < Conditions.Num(); ++ConditionIndex )
+		{
+			const FFactCondition& Condition = Conditions[ ConditionIndex ];
+
+			// same as UFactSubsystem::CheckFactCondition, condition with invalid tag is false regardless of operator
+			const FFactHandle Handle = Condition.Tag.IsValid() ? Condition.GetHandle() : FFactHandle();
+			if ( Handle.IsValid() == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Condition.Tag.ToString() );
+				continue;
+			}
+
+			const int32 FactIndex = Handle.GetIndex();
+			const bool bIsDefined = Storage.IsDefined( FactIndex );
+			
+			FGroup& Group = Groups[ static_cast< int32 >( Condition.Operator ) ];
+			Group.ConditionIndices.Add( ConditionIndex );
+			Group.DefinedMasks.Add( bIsDefined ? ~0 : 0 );
+			if ( IsDefinitionCheck( Condition.Operator ) == false )
+			{
+				Group.Values.Add( bIsDefined ? StorageValues[ FactIndex ] : 0 );
+				Group.WantedValues.Add( Condition.WantedValue );
+			}
+		}
+
+		EvaluateGroup< EFactCompareOperator::Equals >( Groups[ static_cast< int32 >( EFactCompareOperator::Equals ) ], OutResults );
+		EvaluateGroup< EFactCompareOperator::NotEquals >( Groups[ static_cast< int32 >( EFactCompareOperator::NotEquals ) ], OutResults );
+		EvaluateGroup< EFactCompareOperator::Greater >( Groups[ static_cast< int32 >( EFactCompareOperator::Greater ) ], OutResults );
+		EvaluateGroup< EFactCompareOperator::GreaterOrEqual >( Groups[ static_cast< int32 >( EFactCompareOperator::GreaterOrEqual ) ], OutResults );
+		EvaluateGroup< EFactCompareOperator::Less >( Groups[ static_cast< int32 >( EFactCompareOperator::Less ) ], OutResults );
+		EvaluateGroup< EFactCompareOperator::LessOrEqual >( Groups[ static_cast< int32 >( EFactCompareOperator::LessOrEqual ) ], OutResults );
+
+		// definition checks don't need comparisons at all
+		const FGroup& DefinedGroup = Groups[ static_cast< int32 >( EFactCompareOperator::IsDefined ) ];
+		for ( int32 Index = 0; Index < DefinedGroup.ConditionIndices.Num(); ++Index )
+		{
+			OutResults[ DefinedGroup.ConditionIndices[ Index ] ] = DefinedGroup.DefinedMasks[ Index ] != 0;
+		}
+
+		const FGroup& UndefinedGroup = Groups[ static_cast< int32 >( EFactCompareOperator::IsUndefined ) ];
+		for ( int32 Index = 0; Index < UndefinedGroup.ConditionIndices.Num(); ++Index )
+		{
+			OutResults[ UndefinedGroup.ConditionIndices[ Index ] ] = UndefinedGroup.DefinedMasks[ Index ] == 0;
+		}
+	}
+}
@@ -0,0 +1,18 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFactCondition;
+struct FFactStorage;
+
+namespace FactConditionBatch
+{
+	/**
+	 * Evaluates all conditions at once, writing result of condition I into OutResults[ I ].
+	 * Conditions are grouped by operator, values of their facts are gathered into contiguous arrays,
+	 * and every group is compared with SIMD, 4 conditions per instruction.
+	 */
+	void Evaluate( const FFactStorage& Storage, TArrayView< const FFactCondition > Conditions, TBitArray<>& OutResults );
+}
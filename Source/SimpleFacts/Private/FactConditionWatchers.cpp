@@ -0,0 +1,118 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactConditionWatchers.h"
+
+#include "FactStorage.h"
+
+FFactWatcherHandle FFactConditionWatchers::Add( const FFactCompiledExpression& Expression, const FFactStorage& Storage, FFactConditionResultChanged::FDelegate&& Delegate )
+{
+	check( Expression.bIsValid );
+	
+	const int32 Index = FreeWatchers.Num() ? FreeWatchers.Pop() : Watchers.AddDefaulted();
+
+	FWatcher& Watcher = Watchers[ Index ];
+	Watcher.Expression = Expression;
+	Watcher.Delegate = MoveTemp( Delegate );
+	Watcher.bResult = Expression.Evaluate( Storage );
+	Watcher.bIsUsed = true;
+	Watcher.bIsDirty = false;
+
+	for ( const int32 FactIndex : Expression.FactIndices )
+	{
+		if ( FactIndex >= WatchersByFact.Num() )
+		{
+			WatchersByFact.SetNum( FactIndex + 1 );
+		}
+		WatchersByFact[ FactIndex ].Add( Index );
+	}
+
+	FFactWatcherHandle Handle;
+	Handle.Index = Index;
+	Handle.Generation = Watcher.Generation;
+	return Handle;
+}
+
+void FFactConditionWatchers::Remove( FFactWatcherHandle& Handle )
+{
+	if ( Find( Handle ) == nullptr )
+	{
+		Handle.Reset();
+		return;
+	}
+
+	FWatcher& Watcher = Watchers[ Handle.Index ];
+	for ( const int32 FactIndex : Watcher.Expression.FactIndices )
+	{
+		WatchersByFact[ FactIndex ].RemoveSingleSwap( Handle.Index );
+	}
+
+	// watcher can still be in DirtyWatchers, it will be skipped there, because it is not used anymore
+	Watcher.Expression = FFactCompiledExpression();
+	Watcher.Delegate.Unbind();
+	Watcher.bIsUsed = false;
+	++Watcher.Generation;
+	FreeWatchers.Add( Handle.Index );
+	
+	Handle.Reset();
+}
+
+bool FFactConditionWatchers::GetResult( FFactWatcherHandle Handle ) const
+{
+	const FWatcher* Watcher = Find( Handle );
+	return Watcher && Watcher->bResult;
+}
+
+void FFactConditionWatchers::MarkDirty( int32 FactIndex )
+{
+	if ( WatchersByFact.IsValidIndex( FactIndex ) )
+	{
+		for ( const int32 WatcherIndex : WatchersByFact[ FactIndex ] )
+		{
+			FWatcher& Watcher = Watchers[ WatcherIndex ];
+			if ( Watcher.bIsDirty == false )
+			{
+				Watcher.bIsDirty = true;
+				DirtyWatchers.Add( WatcherIndex );
+			}
+		}
+	}
+}
+
+void FFactConditionWatchers::Update( const FFactStorage& Storage )
+{
+	// delegates can change facts (which marks other watchers dirty) or add/remove watchers, so work on a local copy
+	while ( DirtyWatchers.Num() )
+	{
+		TArray< int32 > WatchersToUpdate = MoveTemp( DirtyWatchers );
+		for ( const int32 WatcherIndex : WatchersToUpdate )
+		{
+			FWatcher& Watcher = Watchers[ WatcherIndex ];
+			if ( Watcher.bIsUsed == false || Watcher.bIsDirty == false )
+			{
+				continue;
+			}
+
+			Watcher.bIsDirty = false;
+			const bool bNewResult = Watcher.Expression.Evaluate( Storage );
+			if ( Watcher.bResult != bNewResult )
+			{
+				Watcher.bResult = bNewResult;
+
+				// delegate is copied, because Watchers can be reallocated while it is executed
+				const FFactConditionResultChanged::FDelegate Delegate = Watcher.Delegate;
+				Delegate.ExecuteIfBound( bNewResult );
+			}
+		}
+	}
+}
+
+const FFactConditionWatchers::FWatcher* FFactConditionWatchers::Find( FFactWatcherHandle Handle ) const
+{
+	if ( Watchers.IsValidIndex( Handle.Index ) == false )
+	{
+		return nullptr;
+	}
+	
+	const FWatcher& Watcher = Watchers[ Handle.Index ];
+	return Watcher.bIsUsed && Watcher.Generation == Handle.Generation ? &Watcher : nullptr;
+}
@@ -0,0 +1,34 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactCounters.h"
+
+void FFactCounters::Reset( TConstArrayView< int32 > FactIndices )
+{
+	check( IsInGameThread() );
+
+	Slots.Reset();
+	NumSlots = 0;
+	SlotOfFact.Reset();
+
+	if ( FactIndices.IsEmpty() )
+	{
+		return;
+	}
+
+	int32 MaxFactIndex = INDEX_NONE;
+	for ( const int32 FactIndex : FactIndices )
+	{
+		MaxFactIndex = FMath::Max( MaxFactIndex, FactIndex );
+	}
+
+	SlotOfFact.Init( INDEX_NONE, MaxFactIndex + 1 );
+	Slots = MakeUnique< FSlot[] >( FactIndices.Num() );
+	for ( const int32 FactIndex : FactIndices )
+	{
+		if ( SlotOfFact[ FactIndex ] == INDEX_NONE )
+		{
+			SlotOfFact[ FactIndex ] = NumSlots;
+			Slots[ NumSlots++ ].FactIndex = FactIndex;
+		}
+	}
+}
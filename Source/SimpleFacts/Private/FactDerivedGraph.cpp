@@ -0,0 +1,269 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactDerivedGraph.h"
+
+#include "FactLogChannels.h"
+#include "FactStorage.h"
+#include "FactTagIndex.h"
+
+void FFactDerivedGraph::Add( TConstArrayView< FFactDerivedDefinition > Definitions )
+{
+	for ( const FFactDerivedDefinition& Definition : Definitions )
+	{
+		const FFactHandle Handle = FFactHandle::Resolve( Definition.Tag );
+		if ( Handle.IsValid() == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Definition.Tag.ToString() );
+			continue;
+		}
+
+		if ( IsDerived( Handle.GetIndex() ) )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Fact %s is already derived, skipping its definition" ), *Definition.Tag.ToString() );
+			continue;
+		}
+
+		FNode Node;
+		Node.FactIndex = Handle.GetIndex();
+		Node.Operation = Definition.Operation;
+		Node.bIsDirty = true;
+
+		if ( Definition.Operation == EFactDerivedOperation::Condition )
+		{
+			Node.Expression = Definition.Condition.GetCompiled();
+			if ( Node.Expression.bIsValid == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Condition of derived fact %s is not valid, fact will always be 0" ), *Definition.Tag.ToString() );
+			}
+			Node.SourceIndices = Node.Expression.FactIndices;
+		}
+		else
+		{
+			for ( const FFactTag Source : Definition.Sources )
+			{
+				const FFactHandle SourceHandle = FFactHandle::Resolve( Source );
+				if ( SourceHandle.IsValid() == false )
+				{
+					UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Source.ToString() );
+					continue;
+				}
+				Node.SourceIndices.AddUnique( SourceHandle.GetIndex() );
+			}
+		}
+
+		if ( Node.FactIndex >= NodeOfFact.Num() )
+		{
+			NodeOfFact.Add( INDEX_NONE, FMath::Max( Node.FactIndex + 1, FFactTagIndex::Get().Num() ) - NodeOfFact.Num() );
+		}
+		NodeOfFact[ Node.FactIndex ] = Nodes.Add( MoveTemp( Node ) );
+	}
+
+	BuildOrder();
+}
+
+void FFactDerivedGraph::MarkDirty( int32 FactIndex )
+{
+	if ( IsDerived( FactIndex ) && NodeOfFact[ FactIndex ] != UpdatingNode )
+	{
+		MarkNodeDirty( NodeOfFact[ FactIndex ] );
+	}
+
+	if ( DependentsOfFact.IsValidIndex( FactIndex ) )
+	{
+		for ( const int32 NodeIndex : DependentsOfFact[ FactIndex ] )
+		{
+			MarkNodeDirty( NodeIndex );
+		}
+	}
+}
+
+void FFactDerivedGraph::MarkNodeDirty( int32 NodeIndex )
+{
+	FNode& Node = Nodes[ NodeIndex ];
+	if ( Node.bIsDirty == false )
+	{
+		Node.bIsDirty = true;
+		DirtyNodes.HeapPush( NodeIndex );
+	}
+}
+
+void FFactDerivedGraph::Update( const FFactStorage& Storage, TFunctionRef< void( int32 FactIndex, int32 Value ) > Write )
+{
+	// dependents always have higher rank, so any node, marked dirty by Write, is popped later in this loop
+	while ( DirtyNodes.Num() > 0 )
+	{
+		int32 NodeIndex;
+		DirtyNodes.HeapPop( NodeIndex, EAllowShrinking::No );
+
+		FNode& Node = Nodes[ NodeIndex ];
+		Node.bIsDirty = false;
+
+		const int32 Value = Evaluate( Node, Storage );
+		const int32* CurrentValue = Storage.Find( Node.FactIndex );
+		if ( CurrentValue == nullptr || *CurrentValue != Value )
+		{
+			TGuardValue< int32 > UpdatingGuard( UpdatingNode, NodeIndex );
+			Write( Node.FactIndex, Value );
+		}
+	}
+}
+
+int32 FFactDerivedGraph::Evaluate( const FNode& Node, const FFactStorage& Storage )
+{
+	if ( Node.Operation == EFactDerivedOperation::Condition )
+	{
+		return Node.Expression.bIsValid && Node.Expression.Evaluate( Storage ) ? 1 : 0;
+	}
+
+	// accumulated in wider type, so sum of large values doesn't overflow
+	int32 Count = 0;
+	int64 Result = 0;
+	for ( const int32 SourceIndex : Node.SourceIndices )
+	{
+		const int32* Value = Storage.Find( SourceIndex );
+		if ( Value == nullptr )
+		{
+			continue;
+		}
+
+		switch ( Node.Operation ) {
+			case EFactDerivedOperation::Sum:
+				Result += *Value;
+				break;
+			case EFactDerivedOperation::Count:
+				++Result;
+				break;
+			case EFactDerivedOperation::Min:
+				Result = Count == 0 ? *Value : FMath::Min< int64 >( Result, *Value );
+				break;
+			case EFactDerivedOperation::Max:
+				Result = Count == 0 ? *Value : FMath::Max< int64 >( Result, *Value );
+				break;
+			default:
+				checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+		}
+		++Count;
+	}
+
+	return static_cast< int32 >( FMath::Clamp< int64 >( Result, MIN_int32, MAX_int32 ) );
+}
+
+void FFactDerivedGraph::BuildOrder()
+{
+	// Kahn's algorithm: in-degree of a node is number of its sources, that are derived facts
+	TArray< int32 > InDegrees;
+	InDegrees.SetNumZeroed( Nodes.Num() );
+
+	TArray< TArray< int32 > > Dependents;
+	Dependents.SetNum( Nodes.Num() );
+
+	for ( int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex )
+	{
+		for ( const int32 SourceIndex : Nodes[ NodeIndex ].SourceIndices )
+		{
+			if ( IsDerived( SourceIndex ) )
+			{
+				Dependents[ NodeOfFact[ SourceIndex ] ].Add( NodeIndex );
+				++InDegrees[ NodeIndex ];
+			}
+		}
+	}
+
+	TArray< int32 > Order;
+	Order.Reserve( Nodes.Num() );
+	for ( int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex )
+	{
+		if ( InDegrees[ NodeIndex ] == 0 )
+		{
+			Order.Add( NodeIndex );
+		}
+	}
+
+	for ( int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex )
+	{
+		for ( const int32 Dependent : Dependents[ Order[ OrderIndex ] ] )
+		{
+			if ( --InDegrees[ Dependent ] == 0 )
+			{
+				Order.Add( Dependent );
+			}
+		}
+	}
+
+	if ( Order.Num() < Nodes.Num() )
+	{
+		ReportCycles( InDegrees, Dependents );
+	}
+
+	TArray< FNode > SortedNodes;
+	SortedNodes.Reserve( Order.Num() );
+	for ( const int32 NodeIndex : Order )
+	{
+		SortedNodes.Add( MoveTemp( Nodes[ NodeIndex ] ) );
+	}
+	Nodes = MoveTemp( SortedNodes );
+
+	const int32 NumFacts = FFactTagIndex::Get().Num();
+	NodeOfFact.Init( INDEX_NONE, NumFacts );
+	DependentsOfFact.Reset();
+	DependentsOfFact.SetNum( NumFacts );
+	DirtyNodes.Reset();
+	for ( int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex )
+	{
+		const FNode& Node = Nodes[ NodeIndex ];
+		NodeOfFact[ Node.FactIndex ] = NodeIndex;
+		for ( const int32 SourceIndex : Node.SourceIndices )
+		{
+			DependentsOfFact[ SourceIndex ].Add( NodeIndex );
+		}
+
+		// ascending indices already form a valid heap
+		if ( Node.bIsDirty )
+		{
+			DirtyNodes.Add( NodeIndex );
+		}
+	}
+}
+
+void FFactDerivedGraph::ReportCycles( TConstArrayView< int32 > InDegrees, TConstArrayView< TArray< int32 > > Dependents ) const
+{
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+
+	// node is on a cycle, if it is reachable from itself through unsorted nodes (sorted ones can't be part of any cycle)
+	TBitArray<> Visited;
+	TArray< int32 > Stack;
+	for ( int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex )
+	{
+		if ( InDegrees[ NodeIndex ] == 0 )
+		{
+			continue;
+		}
+
+		Visited.Init( false, Nodes.Num() );
+		Stack.Reset();
+		Stack.Append( Dependents[ NodeIndex ] );
+
+		bool bIsOnCycle = false;
+		while ( Stack.Num() > 0 && bIsOnCycle == false )
+		{
+			const int32 Current = Stack.Pop( EAllowShrinking::No );
+			if ( InDegrees[ Current ] == 0 || Visited[ Current ] )
+			{
+				continue;
+			}
+
+			Visited[ Current ] = true;
+			bIsOnCycle = Current == NodeIndex;
+			Stack.Append( Dependents[ Current ] );
+		}
+
+		if ( bIsOnCycle )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Derived fact %s depends on itself, skipping its definition" ), *TagIndex.GetTag( Nodes[ NodeIndex ].FactIndex ).ToString() );
+		}
+		else
+		{
+			UE_LOG( LogFact, Error, TEXT( "Derived fact %s depends on derived facts, that form a cycle, skipping its definition" ), *TagIndex.GetTag( Nodes[ NodeIndex ].FactIndex ).ToString() );
+		}
+	}
+}
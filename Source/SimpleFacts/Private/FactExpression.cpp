@@ -0,0 +1,224 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactExpression.h"
+
+#include "FactLogChannels.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+namespace
+{
+	// Incremented on every property edit in editor
+	uint32 GPropertyEditSerial = 1;
+
+	FDelayedAutoRegisterHelper GRegisterPropertyEditSerial( EDelayedRegisterRunPhase::EndOfEngineInit, []()
+	{
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda( []( UObject*, FPropertyChangedEvent& )
+		{
+			++GPropertyEditSerial;
+		} );
+	} );
+}
+#endif
+
+const FFactCompiledExpression& FFactExpression::GetCompiled() const
+{
+#if WITH_EDITOR
+	if ( Compiled.IsValid() && CompiledEditSerial != GPropertyEditSerial )
+	{
+		CompiledEditSerial = GPropertyEditSerial;
+		if ( CompiledNodesHash != CalculateNodesHash() )
+		{
+			Compiled.Reset();
+		}
+	}
+#endif
+	
+	if ( Compiled.IsValid() == false )
+	{
+		Compile();
+	}
+
+	return *Compiled;
+}
+
+FString FFactExpression::ToString() const
+{
+	FString Result;
+	for ( const FFactExpressionNode& Node : Nodes )
+	{
+		Result += FString::ChrN( Node.Depth, TEXT( '\t' ) );
+		Result += Node.Type == EFactExpressionNodeType::Condition ? Node.Condition.ToString() : UEnum::GetDisplayValueAsText( Node.Type ).ToString();
+		Result += TEXT( "\n" );
+	}
+
+	return Result;
+}
+
+void FFactExpression::Compile() const
+{
+	TSharedRef< FFactCompiledExpression > NewCompiled = MakeShared< FFactCompiledExpression >();
+	NewCompiled->bIsValid = Nodes.Num() > 0;
+
+	if ( Nodes.Num() == 0 )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Fact expression is empty" ) );
+	}
+	else if ( Nodes[ 0 ].Depth != 0 )
+	{
+		UE_LOG( LogFact, Error, TEXT( "First node of fact expression must have depth 0" ) );
+		NewCompiled->bIsValid = false;
+	}
+	else
+	{
+		const int32 NextNodeIndex = CompileNode( 0, *NewCompiled );
+		if ( NextNodeIndex != INDEX_NONE && NextNodeIndex != Nodes.Num() )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Fact expression must have only one root node, node %d is not part of it" ), NextNodeIndex );
+			NewCompiled->bIsValid = false;
+		}
+	}
+
+	if ( NewCompiled->bIsValid == false )
+	{
+		NewCompiled->Instructions.Reset();
+		NewCompiled->FactIndices.Reset();
+		UE_LOG( LogFact, Error, TEXT( "Failed to compile fact expression:\n%s" ), *ToString() );
+	}
+	
+	Compiled = NewCompiled;
+#if WITH_EDITOR
+	CompiledNodesHash = CalculateNodesHash();
+	CompiledEditSerial = GPropertyEditSerial;
+#endif
+}
+
+int32 FFactExpression::CompileNode( int32 NodeIndex, FFactCompiledExpression& OutCompiled ) const
+{
+	using FInstruction = FFactCompiledExpression::FInstruction;
+	using EOpCode = FFactCompiledExpression::EOpCode;
+	
+	const FFactExpressionNode& Node = Nodes[ NodeIndex ];
+	const int32 OperandDepth = Node.Depth + 1;
+
+	auto IsOperand = [ this, OperandDepth ]( int32 Index )
+	{
+		return Nodes.IsValidIndex( Index ) && Nodes[ Index ].Depth == OperandDepth;
+	};
+
+	switch ( Node.Type ) {
+	case EFactExpressionNodeType::Condition:
+	{
+		const FFactHandle Handle = Node.Condition.GetHandle();
+		if ( Handle.IsValid() == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Node %d of fact expression has invalid fact tag" ), NodeIndex );
+			OutCompiled.bIsValid = false;
+			return INDEX_NONE;
+		}
+		
+		OutCompiled.Instructions.Add( FInstruction{ EOpCode::Test, Node.Condition.Operator, Handle.GetIndex(), Node.Condition.WantedValue } );
+		OutCompiled.FactIndices.AddUnique( Handle.GetIndex() );
+		
+		if ( Nodes.IsValidIndex( NodeIndex + 1 ) && Nodes[ NodeIndex + 1 ].Depth > Node.Depth )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Node %d of fact expression is condition and can't have operands" ), NodeIndex );
+			OutCompiled.bIsValid = false;
+			return INDEX_NONE;
+		}
+		return NodeIndex + 1;
+	}
+	case EFactExpressionNodeType::Not:
+	{
+		if ( IsOperand( NodeIndex + 1 ) == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Node %d of fact expression is NOT and must have exactly one operand" ), NodeIndex );
+			OutCompiled.bIsValid = false;
+			return INDEX_NONE;
+		}
+
+		const int32 NextNodeIndex = CompileNode( NodeIndex + 1, OutCompiled );
+		if ( NextNodeIndex == INDEX_NONE )
+		{
+			return INDEX_NONE;
+		}
+
+		if ( IsOperand( NextNodeIndex ) )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Node %d of fact expression is NOT and must have exactly one operand" ), NodeIndex );
+			OutCompiled.bIsValid = false;
+			return INDEX_NONE;
+		}
+		
+		OutCompiled.Instructions.Add( FInstruction{ EOpCode::Not, EFactCompareOperator::Equals, INDEX_NONE, 0 } );
+		return NextNodeIndex;
+	}
+	case EFactExpressionNodeType::And:
+	case EFactExpressionNodeType::Or:
+	{
+		if ( IsOperand( NodeIndex + 1 ) == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Node %d of fact expression is group and must have at least one operand" ), NodeIndex );
+			OutCompiled.bIsValid = false;
+			return INDEX_NONE;
+		}
+
+		// if result of any operand is already known, jump right to the end of group
+		const EOpCode JumpOpCode = Node.Type == EFactExpressionNodeType::And ? EOpCode::JumpIfFalse : EOpCode::JumpIfTrue;
+		TArray< int32, TInlineAllocator< 8 > > JumpsToPatch;
+		
+		int32 NextNodeIndex = NodeIndex + 1;
+		while ( true )
+		{
+			NextNodeIndex = CompileNode( NextNodeIndex, OutCompiled );
+			if ( NextNodeIndex == INDEX_NONE )
+			{
+				return INDEX_NONE;
+			}
+
+			if ( IsOperand( NextNodeIndex ) == false )
+			{
+				break;
+			}
+
+			JumpsToPatch.Add( OutCompiled.Instructions.Add( FInstruction{ JumpOpCode, EFactCompareOperator::Equals, INDEX_NONE, 0 } ) );
+		}
+
+		for ( const int32 JumpIndex : JumpsToPatch )
+		{
+			OutCompiled.Instructions[ JumpIndex ].Operand = OutCompiled.Instructions.Num();
+		}
+
+		if ( Nodes.IsValidIndex( NextNodeIndex ) && Nodes[ NextNodeIndex ].Depth > OperandDepth )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Node %d of fact expression has depth, that doesn't match its parent" ), NextNodeIndex );
+			OutCompiled.bIsValid = false;
+			return INDEX_NONE;
+		}
+		
+		return NextNodeIndex;
+	}
+	default:
+		checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+	}
+
+	return INDEX_NONE;
+}
+
+#if WITH_EDITOR
+uint32 FFactExpression::CalculateNodesHash() const
+{
+	uint32 Hash = 0;
+	for ( const FFactExpressionNode& Node : Nodes )
+	{
+		Hash = HashCombine( Hash, GetTypeHash( Node.Type ) );
+		Hash = HashCombine( Hash, GetTypeHash( Node.Depth ) );
+		Hash = HashCombine( Hash, GetTypeHash( Node.Condition.Tag ) );
+		Hash = HashCombine( Hash, GetTypeHash( Node.Condition.Operator ) );
+		Hash = HashCombine( Hash, GetTypeHash( Node.Condition.WantedValue ) );
+	}
+
+	return Hash;
+}
+#endif
@@ -0,0 +1,243 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactListenerRegistry.h"
+
+#include "FactTagIndex.h"
+
+FFactChanged& FFactListenerRegistry::FSlot::GetDelegate( EFactListenerType Type )
+{
+	switch ( Type ) {
+	case EFactListenerType::ValueChanged:
+		return OnValueChanged;
+	case EFactListenerType::BecameDefined:
+		return OnBecameDefined;
+	case EFactListenerType::BecameUndefined:
+		return OnBecameUndefined;
+	default:
+		checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+	}
+
+	return OnValueChanged;
+}
+
+bool FFactListenerRegistry::FSlot::IsEmpty() const
+{
+	return OnValueChanged.IsBound() == false && OnBecameDefined.IsBound() == false && OnBecameUndefined.IsBound() == false
+		&& OnSubtreeChanged.IsBound() == false;
+}
+
+FFactListenerHandle FFactListenerRegistry::AddListener( int32 FactIndex, EFactListenerType Type, FFactChanged::FDelegate&& Delegate )
+{
+	const int32 SlotIndex = FindOrAddSlot( FactIndex );
+	FSlot& Slot = GetSlot( SlotIndex );
+
+	FFactListenerHandle Handle;
+	Handle.SlotIndex = SlotIndex;
+	Handle.Generation = Slot.Generation;
+	Handle.DelegateHandle = Slot.GetDelegate( Type ).Add( MoveTemp( Delegate ) );
+	return Handle;
+}
+
+FFactListenerHandle FFactListenerRegistry::AddSubtreeListener( int32 FactIndex, FFactSubtreeChanged::FDelegate&& Delegate )
+{
+	const int32 SlotIndex = FindOrAddSlot( FactIndex );
+	FSlot& Slot = GetSlot( SlotIndex );
+
+	FFactListenerHandle Handle;
+	Handle.SlotIndex = SlotIndex;
+	Handle.Generation = Slot.Generation;
+	Handle.DelegateHandle = Slot.OnSubtreeChanged.Add( MoveTemp( Delegate ) );
+
+	++NumSubtreeListeners;
+	return Handle;
+}
+
+void FFactListenerRegistry::RemoveListener( FFactListenerHandle& Handle )
+{
+	if ( Handle.IsValid() == false || Handle.SlotIndex >= NumSlots )
+	{
+		Handle.Reset();
+		return;
+	}
+
+	FSlot& Slot = GetSlot( Handle.SlotIndex );
+	if ( Slot.Generation == Handle.Generation )
+	{
+		// delegate handles are unique, so there is no need to store listener type in handle
+		Slot.OnValueChanged.Remove( Handle.DelegateHandle );
+		Slot.OnBecameDefined.Remove( Handle.DelegateHandle );
+		Slot.OnBecameUndefined.Remove( Handle.DelegateHandle );
+		if ( Slot.OnSubtreeChanged.Remove( Handle.DelegateHandle ) )
+		{
+			--NumSubtreeListeners;
+		}
+		FreeSlotIfEmpty( Handle.SlotIndex );
+	}
+
+	Handle.Reset();
+}
+
+FFactChanged& FFactListenerRegistry::GetDelegate( int32 FactIndex, EFactListenerType Type )
+{
+	return GetSlot( FindOrAddSlot( FactIndex ) ).GetDelegate( Type );
+}
+
+void FFactListenerRegistry::Broadcast( int32 FactIndex, EFactListenerType Type, int32 Value )
+{
+	const int32 SlotIndex = FindSlot( FactIndex );
+	if ( SlotIndex == INDEX_NONE )
+	{
+		return;
+	}
+
+	++BroadcastDepth;
+	GetSlot( SlotIndex ).GetDelegate( Type ).Broadcast( Value );
+	--BroadcastDepth;
+
+	FreeSlotIfEmpty( SlotIndex );
+	if ( BroadcastDepth == 0 )
+	{
+		FreePendingSlots();
+	}
+}
+
+void FFactListenerRegistry::BroadcastSubtree( int32 FactIndex, int32 Value )
+{
+	if ( NumSubtreeListeners == 0 )
+	{
+		return;
+	}
+
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+	const FFactTag Tag = TagIndex.GetTag( FactIndex );
+
+	++BroadcastDepth;
+	for ( int32 Index = FactIndex; Index != INDEX_NONE; Index = TagIndex.GetParent( Index ) )
+	{
+		const int32 SlotIndex = FindSlot( Index );
+		if ( SlotIndex != INDEX_NONE )
+		{
+			GetSlot( SlotIndex ).OnSubtreeChanged.Broadcast( Tag, Value );
+			FreeSlotIfEmpty( SlotIndex );
+		}
+	}
+	--BroadcastDepth;
+
+	if ( BroadcastDepth == 0 )
+	{
+		FreePendingSlots();
+	}
+}
+
+int32 FFactListenerRegistry::FindSlot( int32 FactIndex ) const
+{
+	return SlotOfFact.IsValidIndex( FactIndex ) ? SlotOfFact[ FactIndex ] : INDEX_NONE;
+}
+
+int32 FFactListenerRegistry::FindOrAddSlot( int32 FactIndex )
+{
+	check( FactIndex >= 0 );
+
+	if ( FactIndex >= SlotOfFact.Num() )
+	{
+		const int32 OldNum = SlotOfFact.Num();
+		SlotOfFact.SetNumUninitialized( FactIndex + 1 );
+		for ( int32 Index = OldNum; Index < SlotOfFact.Num(); ++Index )
+		{
+			SlotOfFact[ Index ] = INDEX_NONE;
+		}
+	}
+	
+	int32& SlotIndex = SlotOfFact[ FactIndex ];
+	if ( SlotIndex != INDEX_NONE )
+	{
+		return SlotIndex;
+	}
+
+	if ( FreeSlots.Num() )
+	{
+		FreeSlots.HeapPop( SlotIndex, EAllowShrinking::No );
+	}
+	else
+	{
+		if ( NumSlots == Pages.Num() * SlotsPerPage )
+		{
+			TUniquePtr< FSlot[] >& Page = Pages.Add_GetRef( MakeUnique< FSlot[] >( SlotsPerPage ) );
+			for ( int32 Index = 0; Index < SlotsPerPage; ++Index )
+			{
+				Page[ Index ].Generation = NextPageGeneration;
+			}
+			NumUsedSlotsInPage.Add( 0 );
+		}
+
+		SlotIndex = NumSlots++;
+	}
+
+	GetSlot( SlotIndex ).FactIndex = FactIndex;
+	++NumUsedSlotsInPage[ SlotIndex / SlotsPerPage ];
+	return SlotIndex;
+}
+
+void FFactListenerRegistry::FreeSlotIfEmpty( int32 SlotIndex )
+{
+	FSlot& Slot = GetSlot( SlotIndex );
+	if ( Slot.FactIndex == INDEX_NONE || Slot.IsEmpty() == false )
+	{
+		return;
+	}
+
+	if ( BroadcastDepth > 0 )
+	{
+		// delegate of this slot can be broadcasting right now, so don't touch it
+		PendingFreeSlots.AddUnique( SlotIndex );
+		return;
+	}
+
+	SlotOfFact[ Slot.FactIndex ] = INDEX_NONE;
+
+	// release memory of invocation lists, slot itself will be reused
+	Slot.OnValueChanged.Clear();
+	Slot.OnBecameDefined.Clear();
+	Slot.OnBecameUndefined.Clear();
+	Slot.OnSubtreeChanged.Clear();
+	Slot.FactIndex = INDEX_NONE;
+	++Slot.Generation;
+
+	FreeSlots.HeapPush( SlotIndex );
+	--NumUsedSlotsInPage[ SlotIndex / SlotsPerPage ];
+	ReleaseEmptyPages();
+}
+
+void FFactListenerRegistry::FreePendingSlots()
+{
+	TArray< int32 > SlotsToFree = MoveTemp( PendingFreeSlots );
+	for ( const int32 SlotIndex : SlotsToFree )
+	{
+		FreeSlotIfEmpty( SlotIndex );
+	}
+}
+
+void FFactListenerRegistry::ReleaseEmptyPages()
+{
+	// first page is always kept, so single listener, that is added and removed repeatedly, doesn't reallocate it
+	bool bReleasedPages = false;
+	while ( Pages.Num() > 1 && NumUsedSlotsInPage.Last() == 0 )
+	{
+		const int32 FirstSlot = ( Pages.Num() - 1 ) * SlotsPerPage;
+		for ( int32 SlotIndex = FirstSlot; SlotIndex < NumSlots; ++SlotIndex )
+		{
+			NextPageGeneration = FMath::Max( NextPageGeneration, GetSlot( SlotIndex ).Generation + 1 );
+		}
+
+		Pages.Pop( EAllowShrinking::No );
+		NumUsedSlotsInPage.Pop( EAllowShrinking::No );
+		NumSlots = FMath::Min( NumSlots, FirstSlot );
+		bReleasedPages = true;
+	}
+
+	if ( bReleasedPages )
+	{
+		FreeSlots.RemoveAll( [ this ]( int32 SlotIndex ) { return SlotIndex >= NumSlots; } );
+		FreeSlots.Heapify();
+	}
+}
@@ -0,0 +1,82 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactPreset.h"
+
+#include "FactLogChannels.h"
+#include "FactTagIndex.h"
+#include "UObject/ObjectSaveContext.h"
+
+bool FFactPresetImage::IsUpToDate() const
+{
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+	return NumTags != INDEX_NONE && NumTags <= TagIndex.Num() && TagIndex.GetSignature( NumTags ) == TagsSignature;
+}
+
+void UFactPreset::PreSave( FObjectPreSaveContext ObjectSaveContext )
+{
+	Super::PreSave( ObjectSaveContext );
+
+	// only cooked preset stores image, in editor it is always built from PresetValues
+	CookedImage = ObjectSaveContext.IsCooking() ? BuildImage() : FFactPresetImage{};
+}
+
+#if WITH_EDITOR
+void UFactPreset::PostEditChangeProperty( FPropertyChangedEvent& PropertyChangedEvent )
+{
+	Super::PostEditChangeProperty( PropertyChangedEvent );
+
+	TransientImage = {};
+}
+#endif
+
+const FFactPresetImage& UFactPreset::GetImage() const
+{
+	if ( CookedImage.IsUpToDate() )
+	{
+		return CookedImage;
+	}
+
+	if ( TransientImage.IsUpToDate() == false )
+	{
+		TransientImage = BuildImage();
+	}
+	return TransientImage;
+}
+
+FFactPresetImage UFactPreset::BuildImage() const
+{
+	FFactTagIndex& TagIndex = FFactTagIndex::Get();
+
+	TArray< TPair< int32, int32 > > Entries;
+	Entries.Reserve( PresetValues.Num() );
+	for ( const auto& [ Tag, Value ] : PresetValues )
+	{
+		const int32 Index = TagIndex.FindOrAdd( Tag );
+		if ( Index == INDEX_NONE )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Fact tag %s in preset %s is not valid" ), *Tag.ToString(), *GetPathName() );
+			continue;
+		}
+
+		Entries.Emplace( Index, Value );
+	}
+
+	// sorted indices let storage be filled front to back
+	Entries.Sort( []( const TPair< int32, int32 >& Lhs, const TPair< int32, int32 >& Rhs )
+	{
+		return Lhs.Key < Rhs.Key;
+	} );
+
+	FFactPresetImage Image;
+	Image.Indices.Reserve( Entries.Num() );
+	Image.Values.Reserve( Entries.Num() );
+	for ( const auto& [ Index, Value ] : Entries )
+	{
+		Image.Indices.Add( Index );
+		Image.Values.Add( Value );
+	}
+
+	Image.NumTags = TagIndex.Num();
+	Image.TagsSignature = TagIndex.GetSignature( Image.NumTags );
+	return Image;
+}
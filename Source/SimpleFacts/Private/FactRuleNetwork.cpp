@@ -0,0 +1,293 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactRuleNetwork.h"
+
+#include "FactLogChannels.h"
+#include "FactRules.h"
+#include "FactStorage.h"
+
+void FFactRuleNetwork::Add( TConstArrayView< FFactRule > NewRules, FObjectKey Owner, const FFactStorage& Storage )
+{
+	for ( const FFactRule& Rule : NewRules )
+	{
+		if ( Rule.Conditions.IsEmpty() )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Fact rule %s has no conditions, skipping it" ), *Rule.Name.ToString() );
+			continue;
+		}
+
+		FRule CompiledRule;
+		CompiledRule.Name = Rule.Name;
+		CompiledRule.Owner = Owner;
+
+		bool bIsValid = true;
+		for ( const FFactCondition& Condition : Rule.Conditions )
+		{
+			const FFactHandle Handle = FFactHandle::Resolve( Condition.Tag );
+			if ( Handle.IsValid() == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Condition.Tag.ToString() );
+				bIsValid = false;
+				break;
+			}
+			CompiledRule.Conditions.Add( { Handle.GetIndex(), Condition.Operator, Condition.WantedValue } );
+		}
+
+		for ( const FFactRuleAction& Action : Rule.Actions )
+		{
+			const FFactHandle Handle = FFactHandle::Resolve( Action.Tag );
+			if ( Handle.IsValid() == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Action.Tag.ToString() );
+				bIsValid = false;
+				break;
+			}
+			CompiledRule.Actions.Add( { Handle.GetIndex(), Action.ChangeType, Action.Value } );
+		}
+
+		if ( bIsValid == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Fact rule %s is not valid, skipping it" ), *Rule.Name.ToString() );
+			continue;
+		}
+
+		Compile( Rules.Add( MoveTemp( CompiledRule ) ), Storage, true );
+	}
+}
+
+void FFactRuleNetwork::Remove( FObjectKey Owner, const FFactStorage& Storage )
+{
+	// removal is rare, so network is simply rebuilt instead of reference counting shared nodes
+	TArray< FRule > RemainingRules = MoveTemp( Rules );
+	RemainingRules.RemoveAll( [ Owner ]( const FRule& Rule ) { return Rule.Owner == Owner; } );
+
+	Rules.Reset();
+	AlphaNodes.Reset();
+	BetaNodes.Reset();
+	AlphaNodesByFact.Reset();
+	BetaNodesByInputs.Reset();
+	Agenda.Reset();
+	AgendaHead = 0;
+	Firings.Reset();
+	CurrentFiring = INDEX_NONE;
+	ActivationDepth = 0;
+
+	for ( FRule& Rule : RemainingRules )
+	{
+		Rule.BetaNode = INDEX_NONE;
+		Rule.bIsQueued = false;
+		Compile( Rules.Add( MoveTemp( Rule ) ), Storage, false );
+	}
+}
+
+bool FFactRuleNetwork::Contains( FObjectKey Owner ) const
+{
+	return Rules.ContainsByPredicate( [ Owner ]( const FRule& Rule ) { return Rule.Owner == Owner; } );
+}
+
+void FFactRuleNetwork::OnFactChanged( int32 FactIndex, const FFactStorage& Storage, bool bActivate )
+{
+	if ( AlphaNodesByFact.IsValidIndex( FactIndex ) == false || AlphaNodesByFact[ FactIndex ].IsEmpty() )
+	{
+		return;
+	}
+
+	// all alpha memories are updated before joining, so rules, that test the fact several times, never see half-updated state
+	const int32* Value = Storage.Find( FactIndex );
+	TArray< int32, TInlineAllocator< 8 > > FlippedNodes;
+	for ( const int32 NodeIndex : AlphaNodesByFact[ FactIndex ] )
+	{
+		FAlphaNode& Node = AlphaNodes[ NodeIndex ];
+		const bool bIsSatisfied = FFactCondition::Compare( Value, Node.Condition.Operator, Node.Condition.WantedValue );
+		if ( Node.bIsSatisfied != bIsSatisfied )
+		{
+			Node.bIsSatisfied = bIsSatisfied;
+			FlippedNodes.Add( NodeIndex );
+		}
+	}
+
+	for ( const int32 NodeIndex : FlippedNodes )
+	{
+		for ( const int32 BetaNodeIndex : AlphaNodes[ NodeIndex ].BetaNodes )
+		{
+			UpdateBetaNode( BetaNodeIndex, bActivate );
+		}
+	}
+}
+
+bool FFactRuleNetwork::PopActivation( FActivation& OutActivation )
+{
+	while ( AgendaHead < Agenda.Num() )
+	{
+		const FQueuedActivation Queued = Agenda[ AgendaHead++ ];
+		FRule& Rule = Rules[ Queued.RuleIndex ];
+		if ( Rule.bIsQueued == false || Rule.ActivationSerial != Queued.Serial )
+		{
+			// retracted before it was fired
+			continue;
+		}
+
+		Rule.bIsQueued = false;
+		OutActivation.RuleIndex = Queued.RuleIndex;
+		OutActivation.Depth = Queued.Depth;
+		OutActivation.Cause = Queued.Cause;
+		return true;
+	}
+
+	// no activation refers to firings anymore
+	Agenda.Reset();
+	AgendaHead = 0;
+	if ( CurrentFiring == INDEX_NONE )
+	{
+		Firings.Reset();
+	}
+	return false;
+}
+
+bool FFactRuleNetwork::BeginFiring( const FActivation& Activation )
+{
+	for ( int32 Ancestor = Activation.Cause; Ancestor != INDEX_NONE; Ancestor = Firings[ Ancestor ].Cause )
+	{
+		if ( Firings[ Ancestor ].RuleIndex == Activation.RuleIndex )
+		{
+			return false;
+		}
+	}
+
+	CurrentFiring = Firings.Add( { Activation.RuleIndex, Activation.Cause } );
+	ActivationDepth = Activation.Depth + 1;
+	return true;
+}
+
+void FFactRuleNetwork::EndFiring()
+{
+	CurrentFiring = INDEX_NONE;
+	ActivationDepth = 0;
+}
+
+void FFactRuleNetwork::Compile( int32 RuleIndex, const FFactStorage& Storage, bool bActivate )
+{
+	TArray< int32, TInlineAllocator< 8 > > RuleAlphaNodes;
+	for ( const FCondition& Condition : Rules[ RuleIndex ].Conditions )
+	{
+		RuleAlphaNodes.AddUnique( FindOrAddAlphaNode( Condition, Storage ) );
+	}
+
+	// canonical order of joins lets rules with the same conditions share whole chain
+	RuleAlphaNodes.Sort();
+
+	int32 BetaNodeIndex = INDEX_NONE;
+	for ( const int32 AlphaNodeIndex : RuleAlphaNodes )
+	{
+		BetaNodeIndex = FindOrAddBetaNode( BetaNodeIndex, AlphaNodeIndex );
+	}
+
+	FRule& Rule = Rules[ RuleIndex ];
+	Rule.BetaNode = BetaNodeIndex;
+	BetaNodes[ BetaNodeIndex ].Rules.Add( RuleIndex );
+
+	if ( bActivate && BetaNodes[ BetaNodeIndex ].bIsSatisfied )
+	{
+		Activate( RuleIndex );
+	}
+}
+
+int32 FFactRuleNetwork::FindOrAddAlphaNode( const FCondition& Condition, const FFactStorage& Storage )
+{
+	if ( Condition.FactIndex >= AlphaNodesByFact.Num() )
+	{
+		AlphaNodesByFact.SetNum( Condition.FactIndex + 1 );
+	}
+
+	TArray< int32 >& FactAlphaNodes = AlphaNodesByFact[ Condition.FactIndex ];
+	for ( const int32 NodeIndex : FactAlphaNodes )
+	{
+		const FCondition& NodeCondition = AlphaNodes[ NodeIndex ].Condition;
+		if ( NodeCondition.Operator == Condition.Operator && NodeCondition.WantedValue == Condition.WantedValue )
+		{
+			return NodeIndex;
+		}
+	}
+
+	const int32 NodeIndex = AlphaNodes.AddDefaulted();
+	FAlphaNode& Node = AlphaNodes[ NodeIndex ];
+	Node.Condition = Condition;
+	Node.bIsSatisfied = FFactCondition::Compare( Storage.Find( Condition.FactIndex ), Condition.Operator, Condition.WantedValue );
+	FactAlphaNodes.Add( NodeIndex );
+	return NodeIndex;
+}
+
+int32 FFactRuleNetwork::FindOrAddBetaNode( int32 Parent, int32 AlphaNode )
+{
+	if ( const int32* ExistingNode = BetaNodesByInputs.Find( { Parent, AlphaNode } ) )
+	{
+		return *ExistingNode;
+	}
+
+	const int32 NodeIndex = BetaNodes.AddDefaulted();
+	FBetaNode& Node = BetaNodes[ NodeIndex ];
+	Node.Parent = Parent;
+	Node.AlphaNode = AlphaNode;
+	Node.bIsSatisfied = ( Parent == INDEX_NONE || BetaNodes[ Parent ].bIsSatisfied ) && AlphaNodes[ AlphaNode ].bIsSatisfied;
+
+	BetaNodesByInputs.Add( { Parent, AlphaNode }, NodeIndex );
+	AlphaNodes[ AlphaNode ].BetaNodes.Add( NodeIndex );
+	if ( Parent != INDEX_NONE )
+	{
+		BetaNodes[ Parent ].Children.Add( NodeIndex );
+	}
+
+	return NodeIndex;
+}
+
+void FFactRuleNetwork::UpdateBetaNode( int32 NodeIndex, bool bActivate )
+{
+	FBetaNode& Node = BetaNodes[ NodeIndex ];
+	const bool bIsSatisfied = ( Node.Parent == INDEX_NONE || BetaNodes[ Node.Parent ].bIsSatisfied ) && AlphaNodes[ Node.AlphaNode ].bIsSatisfied;
+	if ( Node.bIsSatisfied == bIsSatisfied )
+	{
+		return;
+	}
+
+	Node.bIsSatisfied = bIsSatisfied;
+
+	for ( const int32 RuleIndex : Node.Rules )
+	{
+		if ( bIsSatisfied == false )
+		{
+			Retract( RuleIndex );
+		}
+		else if ( bActivate )
+		{
+			Activate( RuleIndex );
+		}
+	}
+
+	// join chains are as long as rules, so recursion stays shallow
+	for ( const int32 ChildIndex : Node.Children )
+	{
+		UpdateBetaNode( ChildIndex, bActivate );
+	}
+}
+
+void FFactRuleNetwork::Activate( int32 RuleIndex )
+{
+	FRule& Rule = Rules[ RuleIndex ];
+	if ( Rule.bIsQueued )
+	{
+		return;
+	}
+
+	Rule.bIsQueued = true;
+	Agenda.Add( { RuleIndex, Rule.ActivationSerial, ActivationDepth, CurrentFiring } );
+}
+
+void FFactRuleNetwork::Retract( int32 RuleIndex )
+{
+	FRule& Rule = Rules[ RuleIndex ];
+	if ( Rule.bIsQueued )
+	{
+		Rule.bIsQueued = false;
+		++Rule.ActivationSerial;
+	}
+}
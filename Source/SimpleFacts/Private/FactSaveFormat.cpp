@@ -0,0 +1,280 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactSaveFormat.h"
+
+#include "FactLogChannels.h"
+#include "FactTagIndex.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+	constexpr uint8 Version = 1;
+	const FName CompressionFormat = NAME_Oodle;
+
+	void WriteVarInt( TArray< uint8 >& Bytes, uint32 Value )
+	{
+		while ( Value >= 0x80 )
+		{
+			Bytes.Add( static_cast< uint8 >( Value | 0x80 ) );
+			Value >>= 7;
+		}
+		Bytes.Add( static_cast< uint8 >( Value ) );
+	}
+
+	uint32 ZigZagEncode( int32 Value )
+	{
+		return ( static_cast< uint32 >( Value ) << 1 ) ^ static_cast< uint32 >( Value >> 31 );
+	}
+
+	int32 ZigZagDecode( uint32 Value )
+	{
+		return static_cast< int32 >( Value >> 1 ) ^ -static_cast< int32 >( Value & 1 );
+	}
+
+	class FReader
+	{
+	public:
+		explicit FReader( TConstArrayView< uint8 > InBytes ) : Bytes( InBytes ) {}
+
+		bool ReadByte( uint8& OutValue )
+		{
+			if ( Offset >= Bytes.Num() )
+			{
+				return false;
+			}
+
+			OutValue = Bytes[ Offset++ ];
+			return true;
+		}
+
+		bool ReadVarInt( uint32& OutValue )
+		{
+			OutValue = 0;
+			for ( int32 Shift = 0; Shift < 35; Shift += 7 )
+			{
+				uint8 Byte;
+				if ( ReadByte( Byte ) == false )
+				{
+					return false;
+				}
+
+				OutValue |= static_cast< uint32 >( Byte & 0x7F ) << Shift;
+				if ( ( Byte & 0x80 ) == 0 )
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool ReadString( FString& OutString )
+		{
+			uint32 Length;
+			if ( ReadVarInt( Length ) == false || Length > static_cast< uint32 >( Bytes.Num() - Offset ) )
+			{
+				return false;
+			}
+
+			const FUTF8ToTCHAR Converter( reinterpret_cast< const ANSICHAR* >( Bytes.GetData() + Offset ), Length );
+			OutString = FString( Converter.Length(), Converter.Get() );
+			Offset += Length;
+			return true;
+		}
+
+	private:
+		TConstArrayView< uint8 > Bytes;
+		int32 Offset = 0;
+	};
+}
+
+namespace FactSaveFormat
+{
+	void FWriter::Add( const FFactTag Tag, int32 Value )
+	{
+		const FTCHARToUTF8 Name( *Tag.ToString() );
+		WriteVarInt( Names, Name.Length() );
+		Names.Append( reinterpret_cast< const uint8* >( Name.Get() ), Name.Length() );
+
+		WriteVarInt( Entries, NumTags++ );
+		WriteVarInt( Entries, ZigZagEncode( Value ) );
+	}
+
+	void FWriter::Finish( TArray< uint8 >& OutBytes ) const
+	{
+		OutBytes.Reset( Names.Num() + Entries.Num() + 11 );
+		OutBytes.Add( Version );
+		WriteVarInt( OutBytes, NumTags );
+		OutBytes.Append( Names );
+		WriteVarInt( OutBytes, NumTags );
+		OutBytes.Append( Entries );
+	}
+
+	bool Read( TConstArrayView< uint8 > Bytes, const FFactTagIndex& TagIndex, TFunctionRef< void( const FName TagName, int32 Index, int32 Value ) > Func )
+	{
+		FReader Reader( Bytes );
+
+		uint8 SavedVersion;
+		if ( Reader.ReadByte( SavedVersion ) == false || SavedVersion != Version )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Saved facts have unsupported version" ) );
+			return false;
+		}
+
+		uint32 NumTags;
+		if ( Reader.ReadVarInt( NumTags ) == false || NumTags > static_cast< uint32 >( Bytes.Num() ) )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Saved facts are corrupted" ) );
+			return false;
+		}
+
+		// saved index -> name and current index
+		TArray< FName > SavedNames;
+		TArray< int32 > Remap;
+		SavedNames.Reserve( NumTags );
+		Remap.Reserve( NumTags );
+		FString Name;
+		for ( uint32 Count = 0; Count < NumTags; ++Count )
+		{
+			if ( Reader.ReadString( Name ) == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Saved facts are corrupted" ) );
+				return false;
+			}
+
+			// GameplayTagsManager is not touched here, names, that are not in index, are resolved on game thread
+			FFactTag Tag;
+			SavedNames.Add( FName( Name ) );
+			Remap.Add( TagIndex.FindByName( SavedNames.Last(), Tag ) );
+		}
+
+		uint32 NumEntries;
+		if ( Reader.ReadVarInt( NumEntries ) == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Saved facts are corrupted" ) );
+			return false;
+		}
+
+		for ( uint32 Count = 0; Count < NumEntries; ++Count )
+		{
+			uint32 SavedIndex;
+			uint32 Value;
+			if ( Reader.ReadVarInt( SavedIndex ) == false || Reader.ReadVarInt( Value ) == false || SavedIndex >= NumTags )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Saved facts are corrupted" ) );
+				return false;
+			}
+
+			Func( SavedNames[ SavedIndex ], Remap[ SavedIndex ], ZigZagDecode( Value ) );
+		}
+
+		return true;
+	}
+
+	void Compress( FFactSaveImage& Image )
+	{
+		if ( Image.PackedFacts.IsEmpty() || Image.PackedFactsUncompressedSize != 0 )
+		{
+			return;
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound( CompressionFormat, Image.PackedFacts.Num() );
+		TArray< uint8 > Compressed;
+		Compressed.SetNumUninitialized( CompressedSize );
+		if ( FCompression::CompressMemory( CompressionFormat, Compressed.GetData(), CompressedSize, Image.PackedFacts.GetData(), Image.PackedFacts.Num() ) )
+		{
+			Compressed.SetNum( CompressedSize );
+			Image.PackedFactsUncompressedSize = Image.PackedFacts.Num();
+			Image.PackedFacts = MoveTemp( Compressed );
+		}
+	}
+
+	FFactLoadResult Decode( const FFactSaveImage& Image, TConstArrayView< FFactSaveDelta > Deltas, const FFactTagIndex& TagIndex, int32 NumFacts )
+	{
+		FFactLoadResult Result;
+		Result.Facts.Reset( NumFacts );
+
+		auto SetFact = [ &Result ]( const FName TagName, int32 Index, int32 Value )
+		{
+			if ( Index != INDEX_NONE )
+			{
+				Result.Facts.Set( Index, Value );
+			}
+			else
+			{
+				Result.UnresolvedFacts.Add( TagName, Value );
+			}
+		};
+
+		if ( Image.PackedFacts.IsEmpty() == false )
+		{
+			TArray< uint8 > Uncompressed;
+			TConstArrayView< uint8 > PackedFacts = Image.PackedFacts;
+			if ( Image.PackedFactsUncompressedSize != 0 )
+			{
+				Uncompressed.SetNumUninitialized( Image.PackedFactsUncompressedSize );
+				if ( FCompression::UncompressMemory( CompressionFormat, Uncompressed.GetData(), Uncompressed.Num(), Image.PackedFacts.GetData(), Image.PackedFacts.Num() ) == false )
+				{
+					UE_LOG( LogFact, Error, TEXT( "Failed to decompress saved facts" ) );
+					Result.bSuccess = false;
+					return Result;
+				}
+				PackedFacts = Uncompressed;
+			}
+
+			Result.bSuccess &= Read( PackedFacts, TagIndex, SetFact );
+		}
+
+		// facts, saved in map format (or before compact format was introduced)
+		for ( const auto& [ Tag, Value ] : Image.Facts )
+		{
+			if ( Tag.IsValid() == false )
+			{
+				UE_LOG( LogFact, Warning, TEXT( "Saved fact tag %s is not valid anymore, skipping it" ), *Tag.ToString() );
+				continue;
+			}
+			SetFact( Tag.GetTagName(), TagIndex.Find( Tag ), Value );
+		}
+
+		for ( const FFactTag Tag : Image.UndefinedFacts )
+		{
+			if ( Tag.IsValid() )
+			{
+				Result.UndefinedFacts.Add( Tag );
+			}
+		}
+
+		// deltas are applied in order of saving, so later ones override earlier
+		for ( const FFactSaveDelta& Delta : Deltas )
+		{
+			if ( Delta.Values.Num() != Delta.Tags.Num() )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Saved facts are corrupted" ) );
+				Result.bSuccess = false;
+				return Result;
+			}
+
+			for ( int32 DeltaIndex = 0; DeltaIndex < Delta.Tags.Num(); ++DeltaIndex )
+			{
+				const FFactTag Tag = Delta.Tags[ DeltaIndex ];
+				if ( Tag.IsValid() == false )
+				{
+					UE_LOG( LogFact, Warning, TEXT( "Saved fact tag %s is not valid anymore, skipping it" ), *Tag.ToString() );
+					continue;
+				}
+				SetFact( Tag.GetTagName(), TagIndex.Find( Tag ), Delta.Values[ DeltaIndex ] );
+			}
+
+			for ( const FFactTag Tag : Delta.UndefinedTags )
+			{
+				Result.Facts.Undefine( TagIndex.Find( Tag ) );
+				Result.UnresolvedFacts.Remove( Tag.GetTagName() );
+				if ( Tag.IsValid() )
+				{
+					Result.UndefinedFacts.Add( Tag );
+				}
+			}
+		}
+
+		return Result;
+	}
+}
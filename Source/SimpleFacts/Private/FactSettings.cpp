@@ -0,0 +1,8 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactSettings.h"
+
+UFactSettings::UFactSettings()
+{
+	CategoryName = TEXT( "Plugins" );
+}
@@ -0,0 +1,166 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactSnapshot.h"
+
+#include "FactExpression.h"
+#include "FactLogChannels.h"
+
+namespace
+{
+	TSharedRef< const FFactSnapshotChunk, ESPMode::ThreadSafe > MakeChunk( const FFactStorage& Storage, int32 ChunkIndex )
+	{
+		TSharedRef< FFactSnapshotChunk, ESPMode::ThreadSafe > Chunk = MakeShared< FFactSnapshotChunk, ESPMode::ThreadSafe >();
+		Storage.CopyChunk( ChunkIndex, Chunk->Values, Chunk->DefinedWords );
+		return Chunk;
+	}
+}
+
+bool FFactSnapshot::GetFactValueIfDefined( const FFactTag Tag, int32& OutValue ) const
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return false;
+	}
+
+	return GetFactValueIfDefined( FFactHandle::Find( Tag ), OutValue );
+}
+
+bool FFactSnapshot::GetFactValueIfDefined( const FFactHandle Handle, int32& OutValue ) const
+{
+	if ( const int32* Value = Find( Handle.GetIndex() ) )
+	{
+		OutValue = *Value;
+		return true;
+	}
+	return false;
+}
+
+bool FFactSnapshot::IsFactDefined( const FFactTag Tag ) const
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return false;
+	}
+
+	return IsFactDefined( FFactHandle::Find( Tag ) );
+}
+
+bool FFactSnapshot::IsFactDefined( const FFactHandle Handle ) const
+{
+	return Find( Handle.GetIndex() ) != nullptr;
+}
+
+bool FFactSnapshot::CheckFactCondition( const FFactCondition& Condition ) const
+{
+	if ( Condition.Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Condition.Tag.ToString() );
+		return false;
+	}
+
+	return CheckFactCondition( FFactHandle::Find( Condition.Tag ), Condition.Operator, Condition.WantedValue );
+}
+
+bool FFactSnapshot::CheckFactCondition( const FFactHandle Handle, EFactCompareOperator Operator, int32 WantedValue ) const
+{
+	return FFactCondition::Compare( Find( Handle.GetIndex() ), Operator, WantedValue );
+}
+
+bool FFactSnapshot::CheckFactExpression( const FFactCompiledExpression& Expression ) const
+{
+	return Expression.bIsValid && Expression.Evaluate( *this );
+}
+
+void FFactSnapshotPublisher::Publish( FFactStorage& Storage )
+{
+	check( IsInGameThread() );
+
+	if ( Latest.IsValid() == false || Storage.HasDirtyChunks() )
+	{
+		const TSharedRef< FFactSnapshot, ESPMode::ThreadSafe > Snapshot = MakeShared< FFactSnapshot, ESPMode::ThreadSafe >();
+		Snapshot->Version = ++LastVersion;
+
+		// share pages with previous snapshot and copy only pages with modified chunks
+		if ( Latest.IsValid() )
+		{
+			Snapshot->Pages = Latest->Pages;
+		}
+
+		const int32 NumChunks = Storage.NumChunks();
+		const int32 NumPages = ( NumChunks + FFactSnapshotChunkPage::NumChunks - 1 ) >> FFactSnapshotChunkPage::ChunkShift;
+		Snapshot->NumChunks = NumChunks;
+		Snapshot->Pages.SetNum( NumPages );
+
+		// pages, that were already copied during this publication
+		TArray< FFactSnapshotChunkPage*, TInlineAllocator< 4 > > WritablePages;
+		WritablePages.SetNumZeroed( NumPages );
+
+		// storage reports new chunks as modified, so every chunk below NumChunks is present after this
+		Storage.ConsumeDirtyChunks( [ &Snapshot, &WritablePages, &Storage, NumChunks ]( int32 ChunkIndex )
+		{
+			if ( ChunkIndex >= NumChunks )
+			{
+				return;
+			}
+
+			const int32 PageIndex = ChunkIndex >> FFactSnapshotChunkPage::ChunkShift;
+			if ( WritablePages[ PageIndex ] == nullptr )
+			{
+				const TSharedPtr< const FFactSnapshotChunkPage, ESPMode::ThreadSafe >& OldPage = Snapshot->Pages[ PageIndex ];
+				const TSharedRef< FFactSnapshotChunkPage, ESPMode::ThreadSafe > NewPage = OldPage.IsValid()
+					? MakeShared< FFactSnapshotChunkPage, ESPMode::ThreadSafe >( *OldPage )
+					: MakeShared< FFactSnapshotChunkPage, ESPMode::ThreadSafe >();
+				WritablePages[ PageIndex ] = &NewPage.Get();
+				Snapshot->Pages[ PageIndex ] = NewPage;
+			}
+
+			WritablePages[ PageIndex ]->Chunks[ ChunkIndex & ( FFactSnapshotChunkPage::NumChunks - 1 ) ] = MakeChunk( Storage, ChunkIndex );
+		} );
+
+		Latest = Snapshot;
+		bLatestPublished = false;
+	}
+
+	if ( bLatestPublished )
+	{
+		return;
+	}
+
+	const int32 Current = CurrentSlot.load();
+	for ( int32 Slot = 0; Slot < NumSlots; ++Slot )
+	{
+		// readers, that have already loaded CurrentSlot, but haven't copied snapshot yet, are still counted here
+		if ( Slot == Current || SlotReaders[ Slot ].load() != 0 )
+		{
+			continue;
+		}
+
+		Slots[ Slot ] = Latest;
+		CurrentSlot.store( Slot );
+		bLatestPublished = true;
+		return;
+	}
+
+	// all free slots are being read at this very moment, very unlikely, snapshot will be published on next call
+}
+
+FFactSnapshotPtr FFactSnapshotPublisher::Acquire() const
+{
+	for ( ;; )
+	{
+		const int32 Slot = CurrentSlot.load();
+		SlotReaders[ Slot ].fetch_add( 1 );
+
+		// slot could be replaced between loading and pinning it, then it can be overwritten at any moment
+		if ( CurrentSlot.load() == Slot )
+		{
+			FFactSnapshotPtr Snapshot = Slots[ Slot ];
+			SlotReaders[ Slot ].fetch_sub( 1 );
+			return Snapshot;
+		}
+
+		SlotReaders[ Slot ].fetch_sub( 1 );
+	}
+}
@@ -18,6 +18,42 @@ void UFactStatics::ChangeFactValue( const UObject* WorldContextObject, const FFa
 	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
 }
 
+void UFactStatics::ChangeFactValues( const UObject* WorldContextObject, const TArray< FFactChange >& Changes )
+{
+	if ( WorldContextObject )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		FactSubsystem.ChangeFactValues( Changes );
+		return;
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+}
+
+void UFactStatics::BeginFactChangeScope( const UObject* WorldContextObject )
+{
+	if ( WorldContextObject )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		FactSubsystem.BeginFactChangeScope();
+		return;
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+}
+
+void UFactStatics::EndFactChangeScope( const UObject* WorldContextObject )
+{
+	if ( WorldContextObject )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		FactSubsystem.EndFactChangeScope();
+		return;
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+}
+
 void UFactStatics::ResetFactValue( const UObject* WorldContextObject, const FFactTag Tag )
 {
 	if ( WorldContextObject )
@@ -59,6 +95,55 @@ bool UFactStatics::IsFactDefined( const UObject* WorldContextObject, const FFact
 	return false;
 }
 
+void UFactStatics::GetFactsUnderTag( const UObject* WorldContextObject, const FFactTag ParentTag, TMap< FFactTag, int32 >& OutFacts )
+{
+	if ( WorldContextObject )
+	{
+		const UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		FactSubsystem.GetFactsUnderTag( ParentTag, OutFacts );
+		return;
+	}
+
+	OutFacts.Reset();
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+}
+
+FFactAggregate UFactStatics::GetFactAggregate( const UObject* WorldContextObject, const FFactTag ParentTag )
+{
+	if ( WorldContextObject )
+	{
+		const UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		return FactSubsystem.GetFactAggregate( ParentTag );
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+	return {};
+}
+
+void UFactStatics::ResetFactsUnderTag( const UObject* WorldContextObject, const FFactTag ParentTag )
+{
+	if ( WorldContextObject )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		FactSubsystem.ResetFactsUnderTag( ParentTag );
+		return;
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+}
+
+void UFactStatics::UndefineFactsUnderTag( const UObject* WorldContextObject, const FFactTag ParentTag )
+{
+	if ( WorldContextObject )
+	{
+		UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		FactSubsystem.UndefineFactsUnderTag( ParentTag );
+		return;
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+}
+
 bool UFactStatics::CheckFactValue( const UObject* WorldContextObject, const FFactTag Tag, int32 WantedValue, EFactCompareOperator Operator )
 {
 	if ( WorldContextObject )
@@ -83,9 +168,20 @@ bool UFactStatics::CheckFactCondition( const UObject* WorldContextObject, FFactC
 	return false;
 }
 
+bool UFactStatics::CheckFactExpression( const UObject* WorldContextObject, const FFactExpression& Expression )
+{
+	if ( WorldContextObject )
+	{
+		const UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+		return FactSubsystem.CheckFactExpression( Expression );
+	}
+
+	UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+	return false;
+}
+
 void UFactStatics::LoadFactPreset( const UObject* WorldContextObject, const UFactPreset* Preset )
 {
-#if !UE_BUILD_SHIPPING
 	if ( WorldContextObject == nullptr )
 	{
 		UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
@@ -99,16 +195,21 @@ void UFactStatics::LoadFactPreset( const UObject* WorldContextObject, const UFac
 	}
 
 	UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
-	for ( auto [ Tag, Value ] : Preset->PresetValues )
-	{
-		FactSubsystem.ChangeFactValue( Tag, Value, EFactValueChangeType::Set );
-	}
-#endif
+	FactSubsystem.LoadFactPreset( Preset->GetImage() );
 }
 
 void UFactStatics::LoadFactPresets( const UObject* WorldContextObject, const TArray< UFactPreset* >& Presets )
 {
-#if !UE_BUILD_SHIPPING
+	if ( WorldContextObject == nullptr )
+	{
+		UE_LOG( LogFact, Error, TEXT( "%hs: WorldContextObject is null" ), __FUNCTION__ );
+		return;
+	}
+
+	// all presets are applied as a single batch, so listeners are notified only once per fact
+	UFactSubsystem& FactSubsystem = UFactSubsystem::Get( WorldContextObject );
+	FFactChangeScope ChangeScope( FactSubsystem );
+	
 	for ( const UFactPreset* Preset : Presets )
 	{
 		if ( Preset == nullptr )
@@ -116,8 +217,7 @@ void UFactStatics::LoadFactPresets( const UObject* WorldContextObject, const TAr
 			UE_LOG( LogFact, Error, TEXT( "%hs: Null preset in TArray" ), __FUNCTION__ );
 			continue;
 		}
-		
-		LoadFactPreset( WorldContextObject, Preset );
+
+		FactSubsystem.LoadFactPreset( Preset->GetImage() );
 	}
-#endif
 }
@@ -0,0 +1,114 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactStorage.h"
+
+void FFactStorage::Reset( int32 NumFacts )
+{
+	Values.Reset();
+	Values.SetNumZeroed( NumFacts );
+	DefinedBits.Init( false, NumFacts );
+	DefinedCount = 0;
+
+	// everything is changed, chunks, that were dropped, are reported as dirty too
+	const int32 NumDirtyChunks = FMath::Max( DirtyChunks.Num(), NumChunks() );
+	for ( int32 ChunkIndex = 0; ChunkIndex < NumDirtyChunks; ++ChunkIndex )
+	{
+		MarkChunkDirtyAt( ChunkIndex );
+	}
+}
+
+void FFactStorage::MarkChunkDirtyAt( int32 ChunkIndex )
+{
+	if ( ChunkIndex >= DirtyChunks.Num() )
+	{
+		DirtyChunks.Add( false, ChunkIndex + 1 - DirtyChunks.Num() );
+	}
+
+	FBitReference IsDirtyBit = DirtyChunks[ ChunkIndex ];
+	if ( IsDirtyBit == false )
+	{
+		IsDirtyBit = true;
+		DirtyChunkList.Add( ChunkIndex );
+	}
+}
+
+void FFactStorage::Set( int32 Index, int32 Value )
+{
+	check( Index >= 0 );
+
+	if ( Index >= Values.Num() )
+	{
+		const int32 OldNumChunks = NumChunks();
+		const int32 NumToAdd = Index + 1 - Values.Num();
+		Values.AddZeroed( NumToAdd );
+		DefinedBits.Add( false, NumToAdd );
+
+		// new chunks are reported as modified, so snapshots never miss them
+		for ( int32 ChunkIndex = OldNumChunks; ChunkIndex < NumChunks(); ++ChunkIndex )
+		{
+			MarkChunkDirtyAt( ChunkIndex );
+		}
+	}
+
+	FBitReference IsDefinedBit = DefinedBits[ Index ];
+	if ( IsDefinedBit == false )
+	{
+		IsDefinedBit = true;
+		++DefinedCount;
+	}
+
+	Values[ Index ] = Value;
+	MarkChunkDirty( Index );
+}
+
+void FFactStorage::Undefine( int32 Index )
+{
+	if ( IsDefined( Index ) )
+	{
+		DefinedBits[ Index ] = false;
+		Values[ Index ] = 0;
+		--DefinedCount;
+		MarkChunkDirty( Index );
+	}
+}
+
+void FFactStorage::CopyChunk( int32 ChunkIndex, int32* OutValues, uint32* OutDefinedWords ) const
+{
+	constexpr int32 NumWords = ChunkSize / NumBitsPerDWORD;
+	
+	const int32 FirstIndex = ChunkIndex << ChunkShift;
+	const int32 NumToCopy = FMath::Clamp( Values.Num() - FirstIndex, 0, ChunkSize );
+
+	FMemory::Memcpy( OutValues, Values.GetData() + FirstIndex, NumToCopy * sizeof( int32 ) );
+	FMemory::Memzero( OutValues + NumToCopy, ( ChunkSize - NumToCopy ) * sizeof( int32 ) );
+
+	// bits after DefinedBits.Num() in the last word are always zero
+	const int32 FirstWord = FirstIndex / NumBitsPerDWORD;
+	const int32 NumWordsToCopy = FMath::Clamp( FMath::DivideAndRoundUp( DefinedBits.Num(), NumBitsPerDWORD ) - FirstWord, 0, NumWords );
+	FMemory::Memcpy( OutDefinedWords, DefinedBits.GetData() + FirstWord, NumWordsToCopy * sizeof( uint32 ) );
+	FMemory::Memzero( OutDefinedWords + NumWordsToCopy, ( NumWords - NumWordsToCopy ) * sizeof( uint32 ) );
+}
+
+bool FFactStorage::IsChunkEqual( int32 ChunkIndex, const FFactStorage& Other ) const
+{
+	constexpr int32 NumWords = ChunkSize / NumBitsPerDWORD;
+
+	const int32 FirstIndex = ChunkIndex << ChunkShift;
+	const int32 EndIndex = FirstIndex + ChunkSize;
+	if ( Values.Num() >= EndIndex && Other.Values.Num() >= EndIndex )
+	{
+		return FMemory::Memcmp( Values.GetData() + FirstIndex, Other.Values.GetData() + FirstIndex, ChunkSize * sizeof( int32 ) ) == 0
+			&& FMemory::Memcmp( DefinedBits.GetData() + FirstIndex / NumBitsPerDWORD, Other.DefinedBits.GetData() + FirstIndex / NumBitsPerDWORD, NumWords * sizeof( uint32 ) ) == 0;
+	}
+
+	// chunk is partially out of bounds of one storage, so compare padded copies
+	int32 ChunkValues[ ChunkSize ];
+	int32 OtherChunkValues[ ChunkSize ];
+	uint32 ChunkWords[ NumWords ];
+	uint32 OtherChunkWords[ NumWords ];
+	CopyChunk( ChunkIndex, ChunkValues, ChunkWords );
+	Other.CopyChunk( ChunkIndex, OtherChunkValues, OtherChunkWords );
+
+	return FMemory::Memcmp( ChunkValues, OtherChunkValues, sizeof( ChunkValues ) ) == 0
+		&& FMemory::Memcmp( ChunkWords, OtherChunkWords, sizeof( ChunkWords ) ) == 0;
+}
@@ -1,12 +1,92 @@
 // Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
 
 #include "FactSubsystem.h"
+#include "FactConditionBatch.h"
+#include "FactDerivedFacts.h"
 #include "FactLogChannels.h"
+#include "FactPreset.h"
+#include "FactRules.h"
 #include "FactSave.h"
+#include "FactSaveFormat.h"
+#include "FactSettings.h"
+#include "FactTagIndex.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 
+namespace
+{
+	/**
+	 * Builds base image of save game in format, selected in settings. FactsType can be FFactStorage or FFactSnapshot.
+	 * Without baseline all defined facts are saved, otherwise only Overrides, that differ from baseline.
+	 * PendingCounters are increments of counter facts, that are not folded yet (they should not be lost).
+	 */
+	template< typename FactsType >
+	FFactSaveImage BuildSaveImage( const FFactTagIndex& TagIndex, bool bCompact, const FactsType& Facts, const TMap< int32, int32 >& PendingCounters,
+		const FFactStorage* Baseline, TConstArrayView< int32 > Overrides )
+	{
+		FFactSaveImage Image;
+		FactSaveFormat::FWriter Writer;
+		auto AddFact = [ &Image, &Writer, &TagIndex, bCompact ]( int32 Index, int32 Value )
+		{
+			if ( bCompact )
+			{
+				Writer.Add( TagIndex.GetTag( Index ), Value );
+			}
+			else
+			{
+				Image.Facts.Add( TagIndex.GetTag( Index ), Value );
+			}
+		};
+
+		if ( Baseline == nullptr )
+		{
+			Facts.ForEachDefined( [ &PendingCounters, &AddFact ]( int32 Index, int32 Value )
+			{
+				const int32* PendingDelta = PendingCounters.Find( Index );
+				AddFact( Index, Value + ( PendingDelta ? *PendingDelta : 0 ) );
+			} );
+
+			for ( const TPair< int32, int32 >& Counter : PendingCounters )
+			{
+				if ( Facts.Find( Counter.Key ) == nullptr )
+				{
+					AddFact( Counter.Key, Counter.Value );
+				}
+			}
+		}
+		else
+		{
+			for ( const int32 Index : Overrides )
+			{
+				const int32* Value = Facts.Find( Index );
+				const int32* PendingDelta = PendingCounters.Find( Index );
+				const int32* BaselineValue = Baseline->Find( Index );
+				if ( Value == nullptr && PendingDelta == nullptr )
+				{
+					if ( BaselineValue != nullptr )
+					{
+						Image.UndefinedFacts.Add( TagIndex.GetTag( Index ) );
+					}
+					continue;
+				}
+
+				const int32 SavedValue = ( Value ? *Value : 0 ) + ( PendingDelta ? *PendingDelta : 0 );
+				if ( BaselineValue == nullptr || *BaselineValue != SavedValue )
+				{
+					AddFact( Index, SavedValue );
+				}
+			}
+		}
+
+		if ( bCompact )
+		{
+			Writer.Finish( Image.PackedFacts );
+		}
+		return Image;
+	}
+}
+
 UFactSubsystem& UFactSubsystem::Get( const UObject* WorldContextObject )
 {
 	UWorld* World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::Assert );
@@ -16,14 +96,1145 @@ UFactSubsystem& UFactSubsystem::Get( const UObject* WorldContextObject )
 	return *FactSubsystem;
 }
 
-void UFactSubsystem::ChangeFactValue( const FFactTag Tag, int32 NewValue, EFactValueChangeType ChangeType )
+void UFactSubsystem::Initialize( FSubsystemCollectionBase& Collection )
+{
+	Super::Initialize( Collection );
+
+	FactStorage.Reset( FFactTagIndex::Get().Num() );
+	Aggregates.Rebuild( FactStorage );
+	SnapshotPublisher->Publish( FactStorage );
+
+	const UFactSettings* Settings = GetDefault< UFactSettings >();
+	TArray< int32 > CounterIndices;
+	for ( const FFactTag CounterTag : Settings->CounterFacts )
+	{
+		const FFactHandle Handle = FFactHandle::Resolve( CounterTag );
+		if ( Handle.IsValid() == false )
+		{
+			UE_LOG( LogFact, Warning, TEXT( "Counter fact tag %s is not valid, skipping it" ), *CounterTag.ToString() );
+			continue;
+		}
+
+		CounterIndices.Add( Handle.GetIndex() );
+	}
+	Counters.Reset( CounterIndices );
+	CounterFoldInterval = Settings->CounterFoldInterval;
+
+	ChangeJournal.Reset( Settings->ChangeJournalCapacity );
+
+	RegisterDerivedFacts( Settings->DerivedFacts );
+
+	for ( const TSoftObjectPtr< UFactRules >& Rules : Settings->Rules )
+	{
+		if ( const UFactRules* LoadedRules = Rules.LoadSynchronous() )
+		{
+			RegisterFactRules( LoadedRules );
+		}
+		else
+		{
+			UE_LOG( LogFact, Warning, TEXT( "Fact rules %s can't be loaded, skipping them" ), *Rules.ToString() );
+		}
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker( FTickerDelegate::CreateUObject( this, &ThisClass::Tick ) );
+}
+
+void UFactSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker( TickerHandle );
+	TickerHandle.Reset();
+
+	// results can't be applied anymore, but tasks may still read data owned by tag index, so they're waited for
+	TArray< FPendingSaveImage > AbandonedSaveImages = MoveTemp( PendingSaveImages );
+	for ( FPendingSaveImage& PendingImage : AbandonedSaveImages )
+	{
+		PendingImage.Task.Wait();
+		PendingImage.OnCompleted.ExecuteIfBound( false );
+	}
+
+	TArray< FPendingLoad > AbandonedLoads = MoveTemp( PendingLoads );
+	for ( FPendingLoad& PendingLoad : AbandonedLoads )
+	{
+		PendingLoad.Task.Wait();
+		PendingLoad.OnCompleted.ExecuteIfBound( false );
+	}
+
+	Super::Deinitialize();
+}
+
+void UFactSubsystem::Serialize( FArchive& Ar )
+{
+	// storage is addressed by indices, that depend on order of tag registration, so it's serialized as map of tags
+	if ( Ar.IsSaving() )
+	{
+		const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+		DefinedFacts.Reserve( FactStorage.NumDefined() );
+		FactStorage.ForEachDefined( [ this, &TagIndex ]( int32 Index, int32 Value )
+		{
+			DefinedFacts.Add( TagIndex.GetTag( Index ), Value );
+		} );
+
+		// pending increments of counters are part of state, even though they aren't folded yet
+		Counters.ForEachPending( [ this, &TagIndex ]( int32 Index, int32 Delta )
+		{
+			DefinedFacts.FindOrAdd( TagIndex.GetTag( Index ) ) += Delta;
+		} );
+	}
+
+	Super::Serialize( Ar );
+
+	if ( Ar.IsLoading() && HasAnyFlags( RF_ClassDefaultObject ) == false )
+	{
+		FFactStorage LoadedFacts;
+		LoadedFacts.Reset( FFactTagIndex::Get().Num() );
+		for ( const TPair< FFactTag, int32 >& Fact : DefinedFacts )
+		{
+			const FFactHandle Handle = FFactHandle::Resolve( Fact.Key );
+			if ( Handle.IsValid() == false )
+			{
+				UE_LOG( LogFact, Warning, TEXT( "Serialized fact %s is not valid fact tag anymore, skipping it" ), *Fact.Key.ToString() );
+				continue;
+			}
+
+			LoadedFacts.Set( Handle.GetIndex(), Fact.Value );
+		}
+
+		// serialized map holds whole state, so every loaded fact is saved again as override
+		ClearOverriddenFacts();
+		LoadedFacts.ForEachDefined( [ this ]( int32 Index, int32 )
+		{
+			MarkFactOverridden( Index );
+		} );
+
+		// pending deltas belong to the state, that is being replaced
+		Counters.Fold( []( int32, int32 ) {} );
+		ReplaceAllFacts( MoveTemp( LoadedFacts ), nullptr );
+	}
+
+	DefinedFacts.Empty();
+}
+
+void UFactSubsystem::ChangeFactValue( const FFactTag Tag, int32 NewValue, EFactValueChangeType ChangeType )
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return;
+	}
+
+	const FFactHandle Handle = FFactHandle::Resolve( Tag );
+	if ( Handle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not registered" ), *Tag.ToString() );
+		return;
+	}
+
+	ChangeFactValue( Handle, NewValue, ChangeType );
+}
+
+void UFactSubsystem::ChangeFactValue( const FFactHandle Handle, int32 NewValue, EFactValueChangeType ChangeType )
+{
+	checkSlow( Handle.IsValid() );
+
+	if ( ChangeType == EFactValueChangeType::Add && Counters.Add( Handle.GetIndex(), NewValue ) )
+	{
+		return;
+	}
+
+	const EFactWriteResult Result = WriteFactValue( Handle.GetIndex(), NewValue, ChangeType );
+	NotifyFactChanged( Handle.GetIndex(), Result );
+}
+
+void UFactSubsystem::ChangeFactValues( TArrayView< const FFactChange > Changes )
+{
+	BeginDeferNotifications();
+	
+	for ( const FFactChange& Change : Changes )
+	{
+		if ( Change.Tag.IsValid() == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Change.Tag.ToString() );
+			continue;
+		}
+
+		const FFactHandle Handle = FFactHandle::Resolve( Change.Tag );
+		if ( Handle.IsValid() == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not registered" ), *Change.Tag.ToString() );
+			continue;
+		}
+
+		if ( Change.ChangeType == EFactValueChangeType::Add && Counters.Add( Handle.GetIndex(), Change.Value ) )
+		{
+			continue;
+		}
+
+		const EFactWriteResult Result = WriteFactValue( Handle.GetIndex(), Change.Value, Change.ChangeType );
+		NotifyFactChanged( Handle.GetIndex(), Result );
+
+		bPendingBatchChanged |= Result != EFactWriteResult::Unchanged;
+	}
+
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::LoadFactPreset( const FFactPresetImage& Image )
+{
+	if ( Image.IsUpToDate() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact preset image was built for different fact tags" ) );
+		return;
+	}
+
+	BeginDeferNotifications();
+
+	for ( int32 EntryIndex = 0; EntryIndex < Image.Indices.Num(); ++EntryIndex )
+	{
+		const int32 Index = Image.Indices[ EntryIndex ];
+		const EFactWriteResult Result = WriteFactValue( Index, Image.Values[ EntryIndex ], EFactValueChangeType::Set );
+		NotifyFactChanged( Index, Result );
+
+		bPendingBatchChanged |= Result != EFactWriteResult::Unchanged;
+	}
+
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::EnqueueFactChange( const FFactTag Tag, int32 NewValue, EFactValueChangeType ChangeType )
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return;
+	}
+
+	// tags can be registered only on game thread, so unknown tag is enqueued as is
+	const int32 Index = FFactHandle::Find( Tag ).GetIndex();
+	if ( ChangeType == EFactValueChangeType::Add && Counters.Add( Index, NewValue ) )
+	{
+		return;
+	}
+
+	QueuedChanges.Enqueue( { Tag, Index, NewValue, ChangeType } );
+}
+
+void UFactSubsystem::EnqueueFactChange( const FFactHandle Handle, int32 NewValue, EFactValueChangeType ChangeType )
+{
+	checkSlow( Handle.IsValid() );
+
+	if ( ChangeType == EFactValueChangeType::Add && Counters.Add( Handle.GetIndex(), NewValue ) )
+	{
+		return;
+	}
+	QueuedChanges.Enqueue( { FFactTag(), Handle.GetIndex(), NewValue, ChangeType } );
+}
+
+void UFactSubsystem::FlushQueuedFactChanges()
+{
+	check( IsInGameThread() );
+
+	FQueuedFactChange Change;
+	while ( QueuedChanges.Dequeue( Change ) )
+	{
+		if ( Change.Index == INDEX_NONE )
+		{
+			Change.Index = FFactHandle::Resolve( Change.Tag ).GetIndex();
+			if ( Change.Index == INDEX_NONE )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not registered" ), *Change.Tag.ToString() );
+				continue;
+			}
+		}
+
+		if ( Change.Index >= MergedChangeOfFact.Num() )
+		{
+			const int32 NumToAdd = FMath::Max( Change.Index + 1, FFactTagIndex::Get().Num() ) - MergedChangeOfFact.Num();
+			MergedChangeOfFact.Reserve( MergedChangeOfFact.Num() + NumToAdd );
+			for ( int32 Count = 0; Count < NumToAdd; ++Count )
+			{
+				MergedChangeOfFact.Add( INDEX_NONE );
+			}
+		}
+
+		int32& MergedIndex = MergedChangeOfFact[ Change.Index ];
+		if ( MergedIndex == INDEX_NONE )
+		{
+			MergedIndex = MergedChanges.Add( Change );
+			continue;
+		}
+
+		// Set overrides everything queued before it, Adds are accumulated on top of previous change
+		FQueuedFactChange& MergedChange = MergedChanges[ MergedIndex ];
+		switch ( Change.ChangeType ) {
+		case EFactValueChangeType::Set:
+			MergedChange.Value = Change.Value;
+			MergedChange.ChangeType = EFactValueChangeType::Set;
+			break;
+		case EFactValueChangeType::Add:
+			MergedChange.Value += Change.Value;
+			break;
+		default:
+			checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+		}
+	}
+
+	if ( MergedChanges.IsEmpty() )
+	{
+		return;
+	}
+
+	// listeners can enqueue or even flush changes again, so work on a local copy
+	TArray< FQueuedFactChange > Changes = MoveTemp( MergedChanges );
+	for ( const FQueuedFactChange& MergedChange : Changes )
+	{
+		MergedChangeOfFact[ MergedChange.Index ] = INDEX_NONE;
+	}
+
+	BeginDeferNotifications();
+
+	for ( const FQueuedFactChange& MergedChange : Changes )
+	{
+		const EFactWriteResult Result = WriteFactValue( MergedChange.Index, MergedChange.Value, MergedChange.ChangeType );
+		NotifyFactChanged( MergedChange.Index, Result );
+
+		bPendingBatchChanged |= Result != EFactWriteResult::Unchanged;
+	}
+
+	EndDeferNotifications();
+}
+
+bool UFactSubsystem::AddToFactCounter( const FFactHandle Handle, int32 Delta )
+{
+	return Counters.Add( Handle.GetIndex(), Delta );
+}
+
+void UFactSubsystem::FoldFactCounters()
+{
+	check( IsInGameThread() );
+
+	TimeSinceCounterFold = 0.f;
+	if ( Counters.IsEmpty() )
+	{
+		return;
+	}
+
+	BeginDeferNotifications();
+
+	Counters.Fold( [ this ]( int32 Index, int32 Delta )
+	{
+		const EFactWriteResult Result = WriteFactValue( Index, Delta, EFactValueChangeType::Add );
+		NotifyFactChanged( Index, Result );
+
+		bPendingBatchChanged |= Result != EFactWriteResult::Unchanged;
+	} );
+
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::BeginFactChangeScope()
+{
+	BeginDeferNotifications();
+}
+
+void UFactSubsystem::EndFactChangeScope()
+{
+	if ( DeferNotificationsCounter == 0 )
+	{
+		UE_LOG( LogFact, Error, TEXT( "EndFactChangeScope is called without matching BeginFactChangeScope" ) );
+		return;
+	}
+
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::ResetFactValue( const FFactTag Tag )
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return;
+	}
+
+	ResetFactValue( FFactHandle::Resolve( Tag ) );
+}
+
+void UFactSubsystem::ResetFactValue( const FFactHandle Handle )
+{
+	Counters.DiscardPendingDelta( Handle.GetIndex() );
+	
+	if ( const int32* CurrentValue = FactStorage.Find( Handle.GetIndex() ) )
+	{
+		constexpr int32 DefaultValue = 0;
+		RecordFactChange( Handle.GetIndex(), CurrentValue, &DefaultValue );
+		FactStorage.Set( Handle.GetIndex(), 0 );
+		NotifyFactChanged( Handle.GetIndex(), EFactWriteResult::ValueChanged );
+	}
+}
+
+bool UFactSubsystem::GetFactValueIfDefined( const FFactTag Tag, int32& OutValue ) const
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return false;
+	}
+
+	return GetFactValueIfDefined( FFactHandle::Resolve( Tag ), OutValue );
+}
+
+bool UFactSubsystem::GetFactValueIfDefined( const FFactHandle Handle, int32& OutValue ) const
+{
+	if ( const int32* TagValue = FactStorage.Find( Handle.GetIndex() ) )
+	{
+		OutValue = *TagValue;
+		return true;
+	}
+	return false;
+}
+
+bool UFactSubsystem::TryGetFactValue( const FFactTag Tag, int32& OutValue ) const
+{
+	return GetFactValueIfDefined( Tag, OutValue );
+}
+
+bool UFactSubsystem::CheckFactCondition( const FFactCondition& Condition ) const
+{
+	if ( Condition.Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Condition.Tag.ToString() );
+		return false;
+	}
+
+	return CheckFactCondition( Condition.GetHandle(), Condition.Operator, Condition.WantedValue );
+}
+
+bool UFactSubsystem::CheckFactCondition( const FFactHandle Handle, EFactCompareOperator Operator, int32 WantedValue ) const
+{
+	return FFactCondition::Compare( FactStorage.Find( Handle.GetIndex() ), Operator, WantedValue );
+}
+
+void UFactSubsystem::CheckFactConditions( TArrayView< const FFactCondition > Conditions, TBitArray<>& OutResults ) const
+{
+	FactConditionBatch::Evaluate( FactStorage, Conditions, OutResults );
+}
+
+bool UFactSubsystem::CheckFactExpression( const FFactExpression& Expression ) const
+{
+	const FFactCompiledExpression& Compiled = Expression.GetCompiled();
+	return Compiled.bIsValid && Compiled.Evaluate( FactStorage );
+}
+
+bool UFactSubsystem::IsFactDefined( const FFactTag Tag ) const
+{
+	if ( Tag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return false;
+	}
+	
+	return IsFactDefined( FFactHandle::Resolve( Tag ) );
+}
+
+bool UFactSubsystem::IsFactDefined( const FFactHandle Handle ) const
+{
+	return FactStorage.IsDefined( Handle.GetIndex() );
+}
+
+void UFactSubsystem::GetFactsUnderTag( const FFactTag ParentTag, TMap< FFactTag, int32 >& OutFacts ) const
+{
+	OutFacts.Reset();
+
+	const FFactHandle ParentHandle = FFactHandle::Resolve( ParentTag );
+	if ( ParentHandle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *ParentTag.ToString() );
+		return;
+	}
+
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+	for ( const int32 Index : TagIndex.GetSubtree( ParentHandle.GetIndex() ) )
+	{
+		if ( const int32* Value = FactStorage.Find( Index ) )
+		{
+			OutFacts.Add( TagIndex.GetTag( Index ), *Value );
+		}
+	}
+}
+
+FFactAggregate UFactSubsystem::GetFactAggregate( const FFactTag ParentTag ) const
+{
+	if ( ParentTag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *ParentTag.ToString() );
+		return {};
+	}
+
+	return GetFactAggregate( FFactHandle::Resolve( ParentTag ) );
+}
+
+FFactAggregate UFactSubsystem::GetFactAggregate( const FFactHandle ParentHandle ) const
+{
+	checkSlow( ParentHandle.IsValid() );
+	return Aggregates.Get( ParentHandle.GetIndex(), FactStorage );
+}
+
+void UFactSubsystem::ResetFactsUnderTag( const FFactTag ParentTag )
+{
+	const FFactHandle ParentHandle = FFactHandle::Resolve( ParentTag );
+	if ( ParentHandle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *ParentTag.ToString() );
+		return;
+	}
+
+	BeginDeferNotifications();
+	for ( const int32 Index : FFactTagIndex::Get().GetSubtree( ParentHandle.GetIndex() ) )
+	{
+		Counters.DiscardPendingDelta( Index );
+
+		const int32* CurrentValue = FactStorage.Find( Index );
+		if ( CurrentValue != nullptr && *CurrentValue != 0 )
+		{
+			constexpr int32 DefaultValue = 0;
+			ApplyFactState( Index, CurrentValue, &DefaultValue );
+		}
+	}
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::UndefineFactsUnderTag( const FFactTag ParentTag )
+{
+	const FFactHandle ParentHandle = FFactHandle::Resolve( ParentTag );
+	if ( ParentHandle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *ParentTag.ToString() );
+		return;
+	}
+
+	BeginDeferNotifications();
+	for ( const int32 Index : FFactTagIndex::Get().GetSubtree( ParentHandle.GetIndex() ) )
+	{
+		Counters.DiscardPendingDelta( Index );
+
+		if ( const int32* CurrentValue = FactStorage.Find( Index ) )
+		{
+			ApplyFactState( Index, CurrentValue, nullptr );
+		}
+	}
+	EndDeferNotifications();
+}
+
+FFactListenerHandle UFactSubsystem::AddFactValueListener( const FFactTag Tag, FFactChanged::FDelegate Delegate )
+{
+	return AddFactListener( Tag, EFactListenerType::ValueChanged, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactValueListener( const FFactHandle Handle, FFactChanged::FDelegate Delegate )
+{
+	checkSlow( Handle.IsValid() );
+	return Listeners.AddListener( Handle.GetIndex(), EFactListenerType::ValueChanged, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactDefinitionListener( const FFactTag Tag, FFactChanged::FDelegate Delegate )
+{
+	return AddFactListener( Tag, EFactListenerType::BecameDefined, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactDefinitionListener( const FFactHandle Handle, FFactChanged::FDelegate Delegate )
+{
+	checkSlow( Handle.IsValid() );
+	return Listeners.AddListener( Handle.GetIndex(), EFactListenerType::BecameDefined, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactUndefinitionListener( const FFactTag Tag, FFactChanged::FDelegate Delegate )
+{
+	return AddFactListener( Tag, EFactListenerType::BecameUndefined, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactUndefinitionListener( const FFactHandle Handle, FFactChanged::FDelegate Delegate )
+{
+	checkSlow( Handle.IsValid() );
+	return Listeners.AddListener( Handle.GetIndex(), EFactListenerType::BecameUndefined, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactSubtreeListener( const FFactTag ParentTag, FFactSubtreeChanged::FDelegate Delegate )
+{
+	if ( ParentTag.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *ParentTag.ToString() );
+		return {};
+	}
+
+	const FFactHandle ParentHandle = FFactHandle::Resolve( ParentTag );
+	if ( ParentHandle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not registered" ), *ParentTag.ToString() );
+		return {};
+	}
+
+	return AddFactSubtreeListener( ParentHandle, MoveTemp( Delegate ) );
+}
+
+FFactListenerHandle UFactSubsystem::AddFactSubtreeListener( const FFactHandle ParentHandle, FFactSubtreeChanged::FDelegate Delegate )
+{
+	checkSlow( ParentHandle.IsValid() );
+	return Listeners.AddSubtreeListener( ParentHandle.GetIndex(), MoveTemp( Delegate ) );
+}
+
+FFactWatcherHandle UFactSubsystem::AddFactConditionWatcher( const FFactExpression& Expression, FFactConditionResultChanged::FDelegate Delegate )
+{
+	const FFactCompiledExpression& Compiled = Expression.GetCompiled();
+	if ( Compiled.bIsValid == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Can't watch invalid fact expression" ) );
+		return {};
+	}
+
+	return ConditionWatchers.Add( Compiled, FactStorage, MoveTemp( Delegate ) );
+}
+
+FFactWatcherHandle UFactSubsystem::AddFactConditionWatcher( const FFactCondition& Condition, FFactConditionResultChanged::FDelegate Delegate )
+{
+	FFactExpression Expression;
+	Expression.Nodes.AddDefaulted_GetRef().Condition = Condition;
+	return AddFactConditionWatcher( Expression, MoveTemp( Delegate ) );
+}
+
+void UFactSubsystem::RemoveFactConditionWatcher( FFactWatcherHandle& Handle )
+{
+	ConditionWatchers.Remove( Handle );
+}
+
+bool UFactSubsystem::GetFactConditionWatcherResult( const FFactWatcherHandle Handle ) const
+{
+	return ConditionWatchers.GetResult( Handle );
+}
+
+FFactThresholdHandle UFactSubsystem::AddFactThresholdListener( const FFactTag Tag, int32 Threshold, FFactThresholdCrossed::FDelegate Delegate )
+{
+	const FFactHandle Handle = FFactHandle::Resolve( Tag );
+	if ( Handle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		return {};
+	}
+
+	return AddFactThresholdListener( Handle, Threshold, MoveTemp( Delegate ) );
+}
+
+FFactThresholdHandle UFactSubsystem::AddFactThresholdListener( const FFactHandle Handle, int32 Threshold, FFactThresholdCrossed::FDelegate Delegate )
+{
+	checkSlow( Handle.IsValid() );
+	return Thresholds.Add( Handle.GetIndex(), Threshold, MoveTemp( Delegate ) );
+}
+
+void UFactSubsystem::RemoveFactThresholdListener( FFactThresholdHandle& Handle )
+{
+	Thresholds.Remove( Handle );
+}
+
+void UFactSubsystem::RemoveFactListener( FFactListenerHandle& Handle )
+{
+	Listeners.RemoveListener( Handle );
+}
+
+FFactChanged& UFactSubsystem::GetOnFactValueChangedDelegate( FFactTag Tag )
+{
+	return GetFactDelegate( Tag, EFactListenerType::ValueChanged );
+}
+
+FFactChanged& UFactSubsystem::GetOnFactBecameDefinedDelegate( FFactTag Tag )
+{
+	return GetFactDelegate( Tag, EFactListenerType::BecameDefined );
+}
+
+TConstArrayView< FFactChangeRecord > UFactSubsystem::GetChangesSince( uint64 Sequence, bool& bOutOverflowed ) const
+{
+	return ChangeJournal.GetChangesSince( Sequence, bOutOverflowed );
+}
+
+void UFactSubsystem::PublishFactSnapshot()
+{
+	SnapshotPublisher->Publish( FactStorage );
+}
+
+FFactCheckpoint UFactSubsystem::TakeFactCheckpoint()
+{
+	FoldFactCounters();
+	SnapshotPublisher->Publish( FactStorage );
+
+	FFactCheckpoint Checkpoint;
+	Checkpoint.Snapshot = SnapshotPublisher->GetLatest();
+	return Checkpoint;
+}
+
+void UFactSubsystem::RestoreFactCheckpoint( const FFactCheckpoint& Checkpoint )
+{
+	if ( Checkpoint.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact checkpoint is not valid" ) );
+		return;
+	}
+
+	// increments were made after checkpoint was taken
+	Counters.Fold( []( int32, int32 ) {} );
+
+	// both current state and checkpoint are snapshots now, so chunks, that weren't changed since checkpoint, are shared
+	SnapshotPublisher->Publish( FactStorage );
+	const FFactSnapshotPtr Current = SnapshotPublisher->GetLatest();
+
+	TGuardValue< bool > SuppressRulesGuard( bSuppressRuleActivations, true );
+	BeginDeferNotifications();
+
+	FFactSnapshot::ForEachDifference( *Current, *Checkpoint.Snapshot, [ this ]( int32 Index, const int32* OldValue, const int32* NewValue )
+	{
+		ApplyFactState( Index, OldValue, NewValue );
+	} );
+
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::OnGameSaved( UFactSaveGame* SaveGame )
+{
+	if ( GetDefault< UFactSettings >()->bIncrementalSaves && LastSaveGame == SaveGame )
+	{
+		SaveFactsIncrementally( SaveGame );
+		return;
+	}
+
+	const bool bCompact = GetDefault< UFactSettings >()->bCompactSaveFormat;
+	const TMap< int32, int32 > PendingCounters = GetPendingCounters();
+	SaveGame->SetBaseImage( BuildSaveImage( FFactTagIndex::Get(), bCompact, FactStorage, PendingCounters, BaselineFacts.Get(), GetSavedOverrides( PendingCounters ) ) );
+	SaveGame->Baseline = BaselinePreset;
+	SaveGame->Deltas.Reset();
+
+	// base image is rewritten, so images, that are being built, would be outdated
+	for ( int32 Index = PendingSaveImages.Num() - 1; Index >= 0; --Index )
+	{
+		if ( PendingSaveImages[ Index ].SaveGame == SaveGame )
+		{
+			FFactSaveCompleted OnCompleted = MoveTemp( PendingSaveImages[ Index ].OnCompleted );
+			PendingSaveImages.RemoveAt( Index );
+			OnCompleted.ExecuteIfBound( false );
+		}
+	}
+
+	UnsavedFacts.Init( false, UnsavedFacts.Num() );
+	LastSaveGame = SaveGame;
+}
+
+void UFactSubsystem::OnGameLoaded( const UFactSaveGame* SaveGame )
+{
+	ApplyLoadedFacts( FactSaveFormat::Decode( SaveGame->GetBaseImage(), SaveGame->Deltas, FFactTagIndex::Get(), FFactTagIndex::Get().Num() ), SaveGame );
+}
+
+void UFactSubsystem::OnGameSavedAsync( UFactSaveGame* SaveGame, FFactSaveCompleted OnCompleted )
+{
+	if ( SaveGame == nullptr )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed save game is null" ) );
+		OnCompleted.ExecuteIfBound( false );
+		return;
+	}
+
+	// everything, changed after this moment, will go into next save
+	UnsavedFacts.Init( false, UnsavedFacts.Num() );
+	LastSaveGame = SaveGame;
+
+	StartSaveImage( SaveGame, true, true, MoveTemp( OnCompleted ) );
+}
+
+void UFactSubsystem::OnGameLoadedAsync( const UFactSaveGame* SaveGame, FFactLoadCompleted OnCompleted )
+{
+	if ( SaveGame == nullptr )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed save game is null" ) );
+		OnCompleted.ExecuteIfBound( false );
+		return;
+	}
+
+	FPendingLoad& PendingLoad = PendingLoads.AddDefaulted_GetRef();
+	PendingLoad.SaveGame = SaveGame;
+	PendingLoad.OnCompleted = MoveTemp( OnCompleted );
+	PendingLoad.Task = UE::Tasks::Launch( UE_SOURCE_LOCATION,
+		[ Image = SaveGame->GetBaseImage(), Deltas = SaveGame->Deltas, &TagIndex = FFactTagIndex::Get(), NumFacts = FFactTagIndex::Get().Num() ]()
+		{
+			return FactSaveFormat::Decode( Image, Deltas, TagIndex, NumFacts );
+		} );
+}
+
+void UFactSubsystem::ApplyLoadedFacts( FFactLoadResult&& LoadResult, const UFactSaveGame* SaveGame )
+{
+	// saved facts are overrides on top of baseline, that was set at the moment of saving
+	if ( SaveGame != nullptr && SaveGame->Baseline != BaselinePreset )
+	{
+		const UFactPreset* Preset = Cast< UFactPreset >( SaveGame->Baseline.TryLoad() );
+		if ( Preset == nullptr && SaveGame->Baseline.IsNull() == false )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Failed to load fact baseline %s of save game" ), *SaveGame->Baseline.ToString() );
+		}
+		SetBaselineLayer( Preset );
+	}
+
+	ClearOverriddenFacts();
+
+	FFactTagIndex& TagIndex = FFactTagIndex::Get();
+	FFactStorage LoadedFacts;
+	if ( BaselineFacts.IsValid() )
+	{
+		LoadedFacts = *BaselineFacts;
+		for ( const FFactTag Tag : LoadResult.UndefinedFacts )
+		{
+			const int32 Index = TagIndex.Find( Tag );
+			if ( Index != INDEX_NONE )
+			{
+				LoadedFacts.Undefine( Index );
+				MarkFactOverridden( Index );
+			}
+		}
+
+		LoadResult.Facts.ForEachDefined( [ this, &LoadedFacts ]( int32 Index, int32 Value )
+		{
+			LoadedFacts.Set( Index, Value );
+			MarkFactOverridden( Index );
+		} );
+	}
+	else
+	{
+		LoadedFacts = MoveTemp( LoadResult.Facts );
+		LoadedFacts.ForEachDefined( [ this ]( int32 Index, int32 )
+		{
+			MarkFactOverridden( Index );
+		} );
+	}
+
+	for ( const auto& [ TagName, Value ] : LoadResult.UnresolvedFacts )
+	{
+		const FFactTag Tag = FFactTag::TryConvert( FGameplayTag::RequestGameplayTag( TagName, false ) );
+		const int32 Index = Tag.IsValid() ? TagIndex.FindOrAdd( Tag ) : INDEX_NONE;
+		if ( Index == INDEX_NONE )
+		{
+			UE_LOG( LogFact, Warning, TEXT( "Saved fact tag %s is not valid anymore, skipping it" ), *TagName.ToString() );
+			continue;
+		}
+
+		LoadedFacts.Set( Index, Value );
+		MarkFactOverridden( Index );
+	}
+
+	// pending deltas belong to the state, that is being replaced
+	Counters.Fold( []( int32, int32 ) {} );
+
+	TArray< FFactTag > ChangedTags;
+	ReplaceAllFacts( MoveTemp( LoadedFacts ), &ChangedTags );
+
+	UnsavedFacts.Init( false, UnsavedFacts.Num() );
+	LastSaveGame = SaveGame;
+
+	OnFactsLoaded.Broadcast( ChangedTags );
+}
+
+void UFactSubsystem::ReplaceAllFacts( FFactStorage&& NewFacts, TArray< FFactTag >* OutChangedTags )
+{
+	FFactStorage PreviousFacts = MoveTemp( FactStorage );
+	FactStorage = MoveTemp( NewFacts );
+
+	// snapshot still matches previous facts except of their unpublished chunks, so only those and chunks, that differ, are dirty
+	FactStorage.ClearDirtyChunks();
+	PreviousFacts.ConsumeDirtyChunks( [ this ]( int32 ChunkIndex )
+	{
+		FactStorage.MarkChunkDirtyAt( ChunkIndex );
+	} );
+
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+	TGuardValue< bool > SuppressRulesGuard( bSuppressRuleActivations, true );
+	BeginDeferNotifications();
+
+	const int32 NumChunks = FMath::Max( PreviousFacts.NumChunks(), FactStorage.NumChunks() );
+	for ( int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex )
+	{
+		// chunks, that were added, are reported as modified, like FFactStorage does on growth
+		if ( ChunkIndex >= PreviousFacts.NumChunks() )
+		{
+			FactStorage.MarkChunkDirtyAt( ChunkIndex );
+		}
+
+		if ( FactStorage.IsChunkEqual( ChunkIndex, PreviousFacts ) )
+		{
+			continue;
+		}
+
+		FactStorage.MarkChunkDirtyAt( ChunkIndex );
+
+		const int32 FirstIndex = ChunkIndex << FFactStorage::ChunkShift;
+		const int32 EndIndex = FMath::Min( FirstIndex + FFactStorage::ChunkSize, TagIndex.Num() );
+		for ( int32 Index = FirstIndex; Index < EndIndex; ++Index )
+		{
+			const int32* OldValue = PreviousFacts.Find( Index );
+			const int32* NewValue = FactStorage.Find( Index );
+			if ( OldValue == nullptr && NewValue == nullptr )
+			{
+				continue;
+			}
+
+			EFactWriteResult Result = EFactWriteResult::ValueChanged;
+			if ( OldValue == nullptr )
+			{
+				Result = EFactWriteResult::BecameDefined;
+			}
+			else if ( NewValue == nullptr )
+			{
+				Result = EFactWriteResult::BecameUndefined;
+			}
+			else if ( *OldValue == *NewValue )
+			{
+				continue;
+			}
+
+			const FFactTag Tag = TagIndex.GetTag( Index );
+			ChangeJournal.Record( Tag, OldValue ? *OldValue : 0, NewValue ? *NewValue : 0 );
+			Aggregates.OnFactChanged( Index, OldValue, NewValue );
+			Thresholds.OnFactChanged( Index, OldValue, NewValue );
+			if ( OutChangedTags != nullptr )
+			{
+				OutChangedTags->Add( Tag );
+			}
+			NotifyFactChanged( Index, Result );
+			bPendingBatchChanged = true;
+		}
+	}
+	EndDeferNotifications();
+}
+
+void UFactSubsystem::ApplyFactState( int32 Index, const int32* OldValue, const int32* NewValue )
+{
+	RecordFactChange( Index, OldValue, NewValue );
+
+	if ( NewValue == nullptr )
+	{
+		FactStorage.Undefine( Index );
+		NotifyFactChanged( Index, EFactWriteResult::BecameUndefined );
+	}
+	else
+	{
+		const bool bWasDefined = OldValue != nullptr;
+		FactStorage.Set( Index, *NewValue );
+		NotifyFactChanged( Index, bWasDefined ? EFactWriteResult::ValueChanged : EFactWriteResult::BecameDefined );
+	}
+	bPendingBatchChanged = true;
+}
+
+void UFactSubsystem::RegisterDerivedFacts( TConstArrayView< FFactDerivedDefinition > Definitions )
+{
+	DerivedFacts.Add( Definitions );
+	UpdateDerivedFacts();
+}
+
+void UFactSubsystem::RegisterDerivedFactsAsset( const UFactDerivedFacts* Asset )
+{
+	if ( Asset == nullptr )
+	{
+		UE_LOG( LogFact, Error, TEXT( "%hs: Asset is null" ), __FUNCTION__ );
+		return;
+	}
+
+	RegisterDerivedFacts( Asset->Definitions );
+}
+
+void UFactSubsystem::RegisterFactRules( const UFactRules* Rules )
+{
+	if ( Rules == nullptr )
+	{
+		UE_LOG( LogFact, Error, TEXT( "%hs: Rules is null" ), __FUNCTION__ );
+		return;
+	}
+
+	if ( RuleNetwork.Contains( Rules ) )
+	{
+		UE_LOG( LogFact, Warning, TEXT( "Fact rules %s are already registered" ), *Rules->GetName() );
+		return;
+	}
+
+	RuleNetwork.Add( Rules->Rules, Rules, FactStorage );
+	if ( DeferNotificationsCounter == 0 )
+	{
+		FireFactRules();
+	}
+}
+
+void UFactSubsystem::UnregisterFactRules( const UFactRules* Rules )
+{
+	if ( Rules == nullptr )
+	{
+		UE_LOG( LogFact, Error, TEXT( "%hs: Rules is null" ), __FUNCTION__ );
+		return;
+	}
+
+	RuleNetwork.Remove( Rules, FactStorage );
+}
+
+void UFactSubsystem::SetFactBaseline( const UFactPreset* Preset )
+{
+	SetBaselineLayer( Preset );
+	ClearOverriddenFacts();
+
+	// increments were made on top of previous state
+	Counters.Fold( []( int32, int32 ) {} );
+
+	FFactStorage NewFacts;
+	if ( BaselineFacts.IsValid() )
+	{
+		NewFacts = *BaselineFacts;
+	}
+	else
+	{
+		// without baseline all facts become undefined, but storage keeps its size, so every chunk stays published
+		NewFacts.Reset( FFactTagIndex::Get().Num() );
+	}
+	ReplaceAllFacts( MoveTemp( NewFacts ), nullptr );
+
+	// previous saves have different baseline, so next save should be full
+	UnsavedFacts.Init( false, UnsavedFacts.Num() );
+	LastSaveGame = nullptr;
+}
+
+void UFactSubsystem::ResetFactsToBaseline()
+{
+	// increments of counters override baseline too
+	Counters.Fold( []( int32, int32 ) {} );
+
+	// restored facts stay marked, so list is not changed while iterating, and is cleared afterwards
+	const TArray< int32 > Overrides = OverriddenFactIndices;
+
+	BeginDeferNotifications();
+	for ( const int32 Index : Overrides )
+	{
+		const int32* Value = FactStorage.Find( Index );
+		const int32* BaselineValue = BaselineFacts.IsValid() ? BaselineFacts->Find( Index ) : nullptr;
+		const bool bIsSame = Value == nullptr ? BaselineValue == nullptr : BaselineValue != nullptr && *Value == *BaselineValue;
+		if ( bIsSame == false )
+		{
+			ApplyFactState( Index, Value, BaselineValue );
+		}
+	}
+	EndDeferNotifications();
+
+	ClearOverriddenFacts();
+}
+
+void UFactSubsystem::SetBaselineLayer( const UFactPreset* Preset )
+{
+	BaselinePreset = FSoftObjectPath( Preset );
+	if ( Preset == nullptr )
+	{
+		BaselineFacts.Reset();
+		return;
+	}
+
+	const FFactPresetImage& Image = Preset->GetImage();
+	const TSharedRef< FFactStorage, ESPMode::ThreadSafe > Baseline = MakeShared< FFactStorage, ESPMode::ThreadSafe >();
+	Baseline->Reset( FFactTagIndex::Get().Num() );
+	for ( int32 EntryIndex = 0; EntryIndex < Image.Indices.Num(); ++EntryIndex )
+	{
+		Baseline->Set( Image.Indices[ EntryIndex ], Image.Values[ EntryIndex ] );
+	}
+	BaselineFacts = Baseline;
+}
+
+void UFactSubsystem::MarkFactOverridden( int32 Index )
+{
+	if ( Index >= OverriddenFacts.Num() )
+	{
+		OverriddenFacts.Add( false, FMath::Max( Index + 1, FFactTagIndex::Get().Num() ) - OverriddenFacts.Num() );
+	}
+
+	FBitReference IsOverriddenBit = OverriddenFacts[ Index ];
+	if ( IsOverriddenBit == false )
+	{
+		IsOverriddenBit = true;
+		OverriddenFactIndices.Add( Index );
+	}
+}
+
+void UFactSubsystem::ClearOverriddenFacts()
+{
+	for ( const int32 Index : OverriddenFactIndices )
+	{
+		OverriddenFacts[ Index ] = false;
+	}
+	OverriddenFactIndices.Reset();
+}
+
+TArray< int32 > UFactSubsystem::GetSavedOverrides( const TMap< int32, int32 >& PendingCounters ) const
+{
+	if ( BaselineFacts.IsValid() == false )
+	{
+		return {};
+	}
+
+	// counters, that are not folded yet, are not marked as overridden
+	TArray< int32 > Overrides = OverriddenFactIndices;
+	for ( const TPair< int32, int32 >& Counter : PendingCounters )
+	{
+		if ( OverriddenFacts.IsValidIndex( Counter.Key ) == false || OverriddenFacts[ Counter.Key ] == false )
+		{
+			Overrides.Add( Counter.Key );
+		}
+	}
+	return Overrides;
+}
+
+TMap< int32, int32 > UFactSubsystem::GetPendingCounters() const
+{
+	TMap< int32, int32 > PendingCounters;
+	Counters.ForEachPending( [ &PendingCounters ]( int32 Index, int32 Delta )
+	{
+		PendingCounters.Add( Index, Delta );
+	} );
+	return PendingCounters;
+}
+
+FFactListenerHandle UFactSubsystem::AddFactListener( const FFactTag Tag, EFactListenerType Type, FFactChanged::FDelegate&& Delegate )
 {
 	if ( Tag.IsValid() == false )
 	{
 		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
-		return;
+		return {};
 	}
-	
+
+	const FFactHandle Handle = FFactHandle::Resolve( Tag );
+	if ( Handle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not registered" ), *Tag.ToString() );
+		return {};
+	}
+
+	return Listeners.AddListener( Handle.GetIndex(), Type, MoveTemp( Delegate ) );
+}
+
+FFactChanged& UFactSubsystem::GetFactDelegate( const FFactTag Tag, EFactListenerType Type )
+{
+	const FFactHandle Handle = FFactHandle::Resolve( Tag );
+	if ( Handle.IsValid() == false )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+
+		// it will never be broadcast, but at least caller will get valid reference
+		static FFactChanged InvalidFactDelegate;
+		return InvalidFactDelegate;
+	}
+
+	return Listeners.GetDelegate( Handle.GetIndex(), Type );
+}
+
+UFactSubsystem::EFactWriteResult UFactSubsystem::WriteFactValue( int32 Index, int32 NewValue, EFactValueChangeType ChangeType )
+{
+	if ( bIsUpdatingDerivedFacts == false && DerivedFacts.IsDerived( Index ) )
+	{
+		UE_LOG( LogFact, Error, TEXT( "Fact %s is derived and can't be changed directly" ), *FFactTagIndex::Get().GetTag( Index ).ToString() );
+		return EFactWriteResult::Unchanged;
+	}
+
 	auto GetUpdatedValue = [ ChangeType, NewValue ] ( const int32 Value )
 	{
 		switch ( ChangeType ) {
@@ -36,154 +1247,409 @@ void UFactSubsystem::ChangeFactValue( const FFactTag Tag, int32 NewValue, EFactV
 			return 0;
 		}
 	};
+
+	// explicit Set overrides increments, that were accumulated before it
+	if ( ChangeType == EFactValueChangeType::Set )
+	{
+		Counters.DiscardPendingDelta( Index );
+	}
 	
-	if ( int32* CurrentValue = DefinedFacts.Find( Tag ) )
+	if ( const int32* CurrentValue = FactStorage.Find( Index ) )
 	{
-		int32 UpdatedValue = GetUpdatedValue( *CurrentValue );
+		const int32 UpdatedValue = GetUpdatedValue( *CurrentValue );
 		if ( *CurrentValue != UpdatedValue )
 		{
-			*CurrentValue = UpdatedValue;
-			BroadcastValueDelegate( Tag, *CurrentValue );
+			RecordFactChange( Index, CurrentValue, &UpdatedValue );
+			FactStorage.Set( Index, UpdatedValue );
+			return EFactWriteResult::ValueChanged;
 		}
-	}
-	else
-	{
-		int32& Value = DefinedFacts.Add( Tag );
-		Value = GetUpdatedValue( Value );
 
-		// first broadcast event, that fact became defined
-		BroadcastDefinitionDelegate( Tag, Value );
-		BroadcastValueDelegate( Tag, Value );
+		return EFactWriteResult::Unchanged;
 	}
+
+	const int32 UpdatedValue = GetUpdatedValue( 0 );
+	RecordFactChange( Index, nullptr, &UpdatedValue );
+	FactStorage.Set( Index, UpdatedValue );
+	return EFactWriteResult::BecameDefined;
 }
 
-void UFactSubsystem::ResetFactValue( const FFactTag Tag )
+void UFactSubsystem::NotifyFactChanged( int32 Index, EFactWriteResult Result )
 {
-	if ( Tag.IsValid() == false )
+	if ( Result == EFactWriteResult::Unchanged )
 	{
-		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
 		return;
 	}
-	
-	if ( DefinedFacts.Contains( Tag ) )
+
+	// watchers and derived facts are marked right away, but re-evaluated only when notifications are dispatched
+	ConditionWatchers.MarkDirty( Index );
+	DerivedFacts.MarkDirty( Index );
+	RuleNetwork.OnFactChanged( Index, FactStorage, bSuppressRuleActivations == false );
+
+	const bool bBecameDefined = Result == EFactWriteResult::BecameDefined;
+	if ( DeferNotificationsCounter > 0 )
+	{
+		if ( Index >= PendingFacts.Num() )
+		{
+			PendingFacts.Add( false, FMath::Max( Index + 1, FFactTagIndex::Get().Num() ) - PendingFacts.Num() );
+		}
+
+		if ( PendingFacts[ Index ] )
+		{
+			// keep the very first state, so listeners know whether fact was defined before deferring
+			return;
+		}
+
+		PendingFacts[ Index ] = true;
+		PendingNotifications.Add( { Index, bBecameDefined } );
+		return;
+	}
+
+	if ( Result == EFactWriteResult::BecameUndefined )
 	{
-		// just re-add fact to map
-		int32 NewValue = DefinedFacts.Add( Tag );
-		BroadcastValueDelegate( Tag, NewValue );
+		BroadcastUndefinitionDelegate( Index );
+		ConditionWatchers.Update( FactStorage );
+		Thresholds.Dispatch();
+		UpdateDerivedFacts();
+		FireFactRules();
+		return;
+	}
+
+	const int32 Value = *FactStorage.Find( Index );
+
+	// first broadcast event, that fact became defined
+	if ( bBecameDefined )
+	{
+		BroadcastDefinitionDelegate( Index, Value );
 	}
+	BroadcastValueDelegate( Index, Value );
+
+	ConditionWatchers.Update( FactStorage );
+	Thresholds.Dispatch();
+	UpdateDerivedFacts();
+	FireFactRules();
 }
 
-bool UFactSubsystem::GetFactValueIfDefined( const FFactTag Tag, int32& OutValue ) const
+void UFactSubsystem::BeginDeferNotifications()
 {
-	if ( Tag.IsValid() == false )
+	++DeferNotificationsCounter;
+}
+
+void UFactSubsystem::EndDeferNotifications()
+{
+	check( DeferNotificationsCounter > 0 );
+
+	// derived facts are recomputed before flush, so their changes are dispatched in the same batch as changes of their sources
+	if ( DeferNotificationsCounter == 1 )
 	{
-		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
-		return false;
+		UpdateDerivedFacts();
 	}
-	
-	if ( const int32* TagValue = DefinedFacts.Find( Tag ) )
+
+	if ( --DeferNotificationsCounter == 0 )
 	{
-		OutValue = *TagValue;
-		return true;
+		FlushPendingNotifications();
 	}
-	return false;
 }
 
-bool UFactSubsystem::TryGetFactValue( const FFactTag Tag, int32& OutValue ) const
+void UFactSubsystem::FlushPendingNotifications()
 {
-	return GetFactValueIfDefined( Tag, OutValue );
+	// listeners can change facts (and even start deferring again), so work on a local copy
+	TArray< FPendingFactNotification > Notifications = MoveTemp( PendingNotifications );
+	for ( const FPendingFactNotification& Notification : Notifications )
+	{
+		PendingFacts[ Notification.Index ] = false;
+	}
+
+	for ( const FPendingFactNotification& Notification : Notifications )
+	{
+		const int32* Value = FactStorage.Find( Notification.Index );
+		if ( Value == nullptr )
+		{
+			// fact, that was defined before deferring, is undefined now
+			if ( Notification.bBecameDefined == false )
+			{
+				BroadcastUndefinitionDelegate( Notification.Index );
+			}
+			continue;
+		}
+
+		// copy value, because storage can be modified by listeners
+		const int32 FinalValue = *Value;
+		if ( Notification.bBecameDefined )
+		{
+			BroadcastDefinitionDelegate( Notification.Index, FinalValue );
+		}
+		BroadcastValueDelegate( Notification.Index, FinalValue );
+	}
+
+	ConditionWatchers.Update( FactStorage );
+	Thresholds.Dispatch();
+
+	if ( bPendingBatchChanged && DeferNotificationsCounter == 0 )
+	{
+		bPendingBatchChanged = false;
+		OnFactsBatchChanged.Broadcast();
+	}
+
+	FireFactRules();
 }
 
-bool UFactSubsystem::CheckFactCondition( const FFactCondition& Condition ) const
+void UFactSubsystem::UpdateDerivedFacts()
 {
-	if ( Condition.Tag.IsValid() == false )
+	if ( DerivedFacts.HasDirtyNodes() == false )
 	{
-		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Condition.Tag.ToString() );
-		return false;
-	}
-	
-	const int32* FactValue = DefinedFacts.Find( Condition.Tag );
-
-	switch ( Condition.Operator ) {
-	case EFactCompareOperator::Equals:
-		return FactValue && *FactValue == Condition.WantedValue;
-	case EFactCompareOperator::NotEquals:
-		return FactValue && *FactValue != Condition.WantedValue;
-	case EFactCompareOperator::Greater:
-		return FactValue && *FactValue > Condition.WantedValue;
-	case EFactCompareOperator::GreaterOrEqual:
-		return FactValue && *FactValue >= Condition.WantedValue;
-	case EFactCompareOperator::Less:
-		return FactValue && *FactValue < Condition.WantedValue;
-	case EFactCompareOperator::LessOrEqual:
-		return FactValue && *FactValue <= Condition.WantedValue;
-	case EFactCompareOperator::IsUndefined:
-		return FactValue == nullptr;
-	case EFactCompareOperator::IsDefined:
-		return FactValue != nullptr;
-	default:
-		checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+		return;
 	}
 
-	return false;
+	BeginDeferNotifications();
+	DerivedFacts.Update( FactStorage, [ this ]( int32 FactIndex, int32 Value )
+	{
+		TGuardValue< bool > UpdatingGuard( bIsUpdatingDerivedFacts, true );
+		const EFactWriteResult Result = WriteFactValue( FactIndex, Value, EFactValueChangeType::Set );
+		NotifyFactChanged( FactIndex, Result );
+		bPendingBatchChanged |= Result != EFactWriteResult::Unchanged;
+	} );
+	EndDeferNotifications();
 }
 
-bool UFactSubsystem::IsFactDefined( const FFactTag Tag ) const
+void UFactSubsystem::FireFactRules()
 {
-	if ( Tag.IsValid() == false )
+	// rules are fired only from outermost call, activations, queued by fired rules, are consumed by the same loop
+	if ( bIsFiringRules || RuleNetwork.HasActivations() == false )
 	{
-		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
-		return false;
+		return;
+	}
+
+	TGuardValue< bool > FiringGuard( bIsFiringRules, true );
+
+	const int32 MaxDepth = GetDefault< UFactSettings >()->MaxRuleChainDepth;
+
+	FFactRuleNetwork::FActivation Activation;
+	while ( RuleNetwork.PopActivation( Activation ) )
+	{
+		if ( Activation.Depth >= MaxDepth )
+		{
+			UE_LOG( LogFact, Warning, TEXT( "Fact rule %s exceeded max chain depth %d and won't be fired" ), *RuleNetwork.GetRuleName( Activation.RuleIndex ).ToString(), MaxDepth );
+			continue;
+		}
+
+		// actions of rule are applied as single batch, rules, activated by them, are queued one level deeper in the same chain
+		if ( RuleNetwork.BeginFiring( Activation ) == false )
+		{
+			UE_LOG( LogFact, Warning, TEXT( "Fact rule %s was activated again by its own chain of rules (cycle) and won't be fired" ), *RuleNetwork.GetRuleName( Activation.RuleIndex ).ToString() );
+			continue;
+		}
+
+		BeginDeferNotifications();
+		for ( const FFactRuleNetwork::FAction& Action : RuleNetwork.GetActions( Activation.RuleIndex ) )
+		{
+			const EFactWriteResult Result = WriteFactValue( Action.FactIndex, Action.Value, Action.ChangeType );
+			NotifyFactChanged( Action.FactIndex, Result );
+			bPendingBatchChanged |= Result != EFactWriteResult::Unchanged;
+		}
+		EndDeferNotifications();
+		RuleNetwork.EndFiring();
 	}
-	
-	return DefinedFacts.Contains( Tag );
 }
 
-FFactChanged& UFactSubsystem::GetOnFactValueChangedDelegate( FFactTag Tag )
+void UFactSubsystem::BroadcastValueDelegate( int32 Index, int32 Value )
 {
-	if ( Tag.IsValid() == false )
+	Listeners.Broadcast( Index, EFactListenerType::ValueChanged, Value );
+	Listeners.BroadcastSubtree( Index, Value );
+}
+
+void UFactSubsystem::BroadcastDefinitionDelegate( int32 Index, int32 Value )
+{
+	Listeners.Broadcast( Index, EFactListenerType::BecameDefined, Value );
+}
+
+void UFactSubsystem::BroadcastUndefinitionDelegate( int32 Index )
+{
+	Listeners.Broadcast( Index, EFactListenerType::BecameUndefined, 0 );
+}
+
+void UFactSubsystem::RecordFactChange( int32 Index, const int32* OldValue, const int32* NewValue )
+{
+	ChangeJournal.Record( FFactTagIndex::Get().GetTag( Index ), OldValue != nullptr ? *OldValue : 0, NewValue != nullptr ? *NewValue : 0 );
+	Aggregates.OnFactChanged( Index, OldValue, NewValue );
+	Thresholds.OnFactChanged( Index, OldValue, NewValue );
+
+	if ( Index >= UnsavedFacts.Num() )
 	{
-		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		UnsavedFacts.Add( false, FMath::Max( Index + 1, FFactTagIndex::Get().Num() ) - UnsavedFacts.Num() );
 	}
-	
-	return ValueDelegates.FindOrAdd( Tag );
+	UnsavedFacts[ Index ] = true;
+
+	MarkFactOverridden( Index );
 }
 
-FFactChanged& UFactSubsystem::GetOnFactBecameDefinedDelegate( FFactTag Tag )
+void UFactSubsystem::SaveFactsIncrementally( UFactSaveGame* SaveGame )
 {
-	if ( Tag.IsValid() == false )
+	const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+
+	// increments of counters, that are not folded yet, should not be lost
+	TBitArray<> FactsToSave = UnsavedFacts;
+	Counters.ForEachPending( [ &FactsToSave ]( int32 Index, int32 Delta )
 	{
-		UE_LOG( LogFact, Error, TEXT( "Passed fact tag %s is not valid" ), *Tag.ToString() );
+		if ( Index >= FactsToSave.Num() )
+		{
+			FactsToSave.Add( false, Index + 1 - FactsToSave.Num() );
+		}
+		FactsToSave[ Index ] = true;
+	} );
+
+	FFactSaveDelta Delta;
+	for ( TConstSetBitIterator<> It( FactsToSave ); It; ++It )
+	{
+		const int32 Index = It.GetIndex();
+		const int32* Value = FactStorage.Find( Index );
+		const int32 PendingDelta = Counters.GetPendingDelta( Index );
+		if ( Value || PendingDelta != 0 )
+		{
+			Delta.Tags.Add( TagIndex.GetTag( Index ) );
+			Delta.Values.Add( ( Value ? *Value : 0 ) + PendingDelta );
+		}
+		else
+		{
+			Delta.UndefinedTags.Add( TagIndex.GetTag( Index ) );
+		}
 	}
-	
-	return DefinitionDelegates.FindOrAdd( Tag );
+
+	UnsavedFacts.Init( false, UnsavedFacts.Num() );
+
+	if ( Delta.Tags.IsEmpty() && Delta.UndefinedTags.IsEmpty() )
+	{
+		return;
+	}
+	SaveGame->Deltas.Add( MoveTemp( Delta ) );
+
+	const bool bIsCompacting = PendingSaveImages.ContainsByPredicate( [ SaveGame ]( const FPendingSaveImage& PendingImage )
+	{
+		return PendingImage.SaveGame == SaveGame;
+	} );
+
+	const UFactSettings* Settings = GetDefault< UFactSettings >();
+	if ( SaveGame->Deltas.Num() >= Settings->MaxSaveDeltas && bIsCompacting == false )
+	{
+		StartSaveImage( SaveGame, Settings->bCompactSaveFormat, false, {} );
+	}
+}
+
+void UFactSubsystem::StartSaveImage( UFactSaveGame* SaveGame, bool bCompact, bool bCompress, FFactSaveCompleted&& OnCompleted )
+{
+	// save game matches current state of facts, so new base image can be built from snapshot without touching save game
+	PublishFactSnapshot();
+	FFactSnapshotPtr Snapshot = GetFactSnapshot();
+
+	TMap< int32, int32 > PendingCounters = GetPendingCounters();
+	TArray< int32 > Overrides = GetSavedOverrides( PendingCounters );
+
+	FPendingSaveImage& PendingImage = PendingSaveImages.AddDefaulted_GetRef();
+	PendingImage.SaveGame = SaveGame;
+	PendingImage.NumDeltas = SaveGame->Deltas.Num();
+	PendingImage.Baseline = BaselinePreset;
+	PendingImage.OnCompleted = MoveTemp( OnCompleted );
+	PendingImage.Task = UE::Tasks::Launch( UE_SOURCE_LOCATION,
+		[ Snapshot = MoveTemp( Snapshot ), PendingCounters = MoveTemp( PendingCounters ), Baseline = BaselineFacts, Overrides = MoveTemp( Overrides ), &TagIndex = FFactTagIndex::Get(), bCompact, bCompress ]()
+		{
+			FFactSaveImage Image;
+
+			TagIndex.ReadLocked( [ & ]()
+			{
+				Image = BuildSaveImage( TagIndex, bCompact, *Snapshot, PendingCounters, Baseline.Get(), Overrides );
+			} );
+
+			if ( bCompress )
+			{
+				FactSaveFormat::Compress( Image );
+			}
+
+			return Image;
+		} );
 }
 
-void UFactSubsystem::OnGameSaved( UFactSaveGame* SaveGame ) const
+void UFactSubsystem::FinishSaveImages()
 {
-	SaveGame->Facts = DefinedFacts;
+	while ( PendingSaveImages.Num() > 0 && PendingSaveImages[ 0 ].Task.IsCompleted() )
+	{
+		FPendingSaveImage PendingImage = MoveTemp( PendingSaveImages[ 0 ] );
+		PendingSaveImages.RemoveAt( 0 );
+
+		UFactSaveGame* SaveGame = PendingImage.SaveGame.Get();
+		if ( SaveGame == nullptr )
+		{
+			PendingImage.OnCompleted.ExecuteIfBound( false );
+			continue;
+		}
+
+		// deltas, that were saved after image had been started, stay on top of new base image
+		const int32 NumDeltas = FMath::Min( PendingImage.NumDeltas, SaveGame->Deltas.Num() );
+		SaveGame->SetBaseImage( MoveTemp( PendingImage.Task.GetResult() ) );
+		SaveGame->Baseline = PendingImage.Baseline;
+		SaveGame->Deltas.RemoveAt( 0, NumDeltas );
+
+		for ( FPendingSaveImage& OtherImage : PendingSaveImages )
+		{
+			if ( OtherImage.SaveGame == SaveGame )
+			{
+				OtherImage.NumDeltas = FMath::Max( OtherImage.NumDeltas - NumDeltas, 0 );
+			}
+		}
+
+		PendingImage.OnCompleted.ExecuteIfBound( true );
+	}
 }
 
-void UFactSubsystem::OnGameLoaded( const UFactSaveGame* SaveGame )
+void UFactSubsystem::FinishLoads()
 {
-	DefinedFacts = SaveGame->Facts;
+	while ( PendingLoads.Num() > 0 && PendingLoads[ 0 ].Task.IsCompleted() )
+	{
+		FPendingLoad PendingLoad = MoveTemp( PendingLoads[ 0 ] );
+		PendingLoads.RemoveAt( 0 );
+
+		FFactLoadResult& LoadResult = PendingLoad.Task.GetResult();
+		const bool bSuccess = LoadResult.bSuccess;
+		if ( bSuccess )
+		{
+			ApplyLoadedFacts( MoveTemp( LoadResult ), PendingLoad.SaveGame.Get() );
+		}
 
-	OnFactsLoaded.Broadcast();
+		PendingLoad.OnCompleted.ExecuteIfBound( bSuccess );
+	}
 }
 
-void UFactSubsystem::BroadcastValueDelegate( const FFactTag Tag, int32 Value )
+bool UFactSubsystem::Tick( float DeltaTime )
 {
-	if ( FFactChanged* Delegate = ValueDelegates.Find( Tag ) )
+	FinishSaveImages();
+	FinishLoads();
+
+	FlushQueuedFactChanges();
+
+	TimeSinceCounterFold += DeltaTime;
+	if ( TimeSinceCounterFold >= CounterFoldInterval )
 	{
-		Delegate->Broadcast( Value );
+		FoldFactCounters();
 	}
+
+	SnapshotPublisher->Publish( FactStorage );
+	return true;
+}
+
+FFactChangeScope::FFactChangeScope( UFactSubsystem& InFactSubsystem )
+	: FactSubsystem( &InFactSubsystem )
+{
+	InFactSubsystem.BeginFactChangeScope();
 }
 
-void UFactSubsystem::BroadcastDefinitionDelegate( const FFactTag Tag, int32 Value )
+FFactChangeScope::FFactChangeScope( const UObject* WorldContextObject )
+	: FFactChangeScope( UFactSubsystem::Get( WorldContextObject ) )
 {
-	if ( FFactChanged* Delegate = DefinitionDelegates.Find( Tag ) )
+}
+
+FFactChangeScope::~FFactChangeScope()
+{
+	if ( UFactSubsystem* Subsystem = FactSubsystem.Get() )
 	{
-		Delegate->Broadcast( Value );
+		Subsystem->EndFactChangeScope();
 	}
 }
 
@@ -283,10 +1749,99 @@ FAutoConsoleCommandWithWorld UFactSubsystem::DumpFactsCommand
 			UFactSubsystem& FactSubsystem = UFactSubsystem::Get( World );
 			UE_LOG( LogFact, Log, TEXT( "Dumping all defined facts" ) );
 
-			for ( auto& [ Tag, Value] : FactSubsystem.DefinedFacts )
+			const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+			FactSubsystem.FactStorage.ForEachDefined( [ &TagIndex ]( int32 Index, int32 Value )
+			{
+				UE_LOG( LogFact, Log, TEXT( "%s: %d" ), *TagIndex.GetTag( Index ).ToString(), Value );
+			} );
+		}
+	} )
+);
+
+FAutoConsoleCommandWithWorldAndArgs UFactSubsystem::GetFactsUnderTagCommand
+(
+	TEXT( "Facts.GetUnderTag" ),
+	TEXT( "Prints values of all defined facts under given tag (including the tag itself)" ),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda( []( const TArray< FString >& Args, UWorld* World )
+	{
+		// Facts.GetUnderTag Fact.Tag
+		if ( Args.Num() < 1 )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Incorrect number of arguments. Facts.GetUnderTag Fact.Tag" ) );
+			return;
+		}
+
+		if ( World )
+		{
+			const FFactTag Tag = FFactTag::TryConvert( FGameplayTag::RequestGameplayTag( FName( Args[ 0 ] ) ) );
+			if ( Tag.IsValid() == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Incorrect tag: %s" ), *Args[ 0 ] );
+				return;
+			}
+
+			TMap< FFactTag, int32 > Facts;
+			UFactSubsystem::Get( World ).GetFactsUnderTag( Tag, Facts );
+
+			UE_LOG( LogFact, Log, TEXT( "Dumping %d defined facts under %s" ), Facts.Num(), *Tag.ToString() );
+			for ( const auto& [ FactTag, Value ] : Facts )
+			{
+				UE_LOG( LogFact, Log, TEXT( "%s: %d" ), *FactTag.ToString(), Value );
+			}
+		}
+	} )
+);
+
+FAutoConsoleCommandWithWorldAndArgs UFactSubsystem::ResetFactsUnderTagCommand
+(
+	TEXT( "Facts.ResetUnderTag" ),
+	TEXT( "Resets values of all defined facts under given tag (including the tag itself)" ),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda( []( const TArray< FString >& Args, UWorld* World )
+	{
+		// Facts.ResetUnderTag Fact.Tag
+		if ( Args.Num() < 1 )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Incorrect number of arguments. Facts.ResetUnderTag Fact.Tag" ) );
+			return;
+		}
+
+		if ( World )
+		{
+			const FFactTag Tag = FFactTag::TryConvert( FGameplayTag::RequestGameplayTag( FName( Args[ 0 ] ) ) );
+			if ( Tag.IsValid() == false )
+			{
+				UE_LOG( LogFact, Error, TEXT( "Incorrect tag: %s" ), *Args[ 0 ] );
+				return;
+			}
+
+			UFactSubsystem::Get( World ).ResetFactsUnderTag( Tag );
+		}
+	} )
+);
+
+FAutoConsoleCommandWithWorldAndArgs UFactSubsystem::UndefineFactsUnderTagCommand
+(
+	TEXT( "Facts.UndefineUnderTag" ),
+	TEXT( "Makes all facts under given tag (including the tag itself) undefined" ),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda( []( const TArray< FString >& Args, UWorld* World )
+	{
+		// Facts.UndefineUnderTag Fact.Tag
+		if ( Args.Num() < 1 )
+		{
+			UE_LOG( LogFact, Error, TEXT( "Incorrect number of arguments. Facts.UndefineUnderTag Fact.Tag" ) );
+			return;
+		}
+
+		if ( World )
+		{
+			const FFactTag Tag = FFactTag::TryConvert( FGameplayTag::RequestGameplayTag( FName( Args[ 0 ] ) ) );
+			if ( Tag.IsValid() == false )
 			{
-				UE_LOG( LogFact, Log, TEXT( "%s: %d" ), *Tag.ToString(), Value );
+				UE_LOG( LogFact, Error, TEXT( "Incorrect tag: %s" ), *Args[ 0 ] );
+				return;
 			}
+
+			UFactSubsystem::Get( World ).UndefineFactsUnderTag( Tag );
 		}
 	} )
 );
@@ -0,0 +1,181 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactTagIndex.h"
+
+#include "FactLogChannels.h"
+#include "GameplayTagsManager.h"
+
+FFactTagIndex& FFactTagIndex::Get()
+{
+	static FFactTagIndex Instance;
+	return Instance;
+}
+
+FFactTagIndex::FFactTagIndex()
+{
+	check( IsInGameThread() );
+
+	const TSharedPtr< FGameplayTagNode > RootNode = UGameplayTagsManager::Get().FindTagNode( FFactTag::GetRootTag() );
+	if ( RootNode.IsValid() )
+	{
+		AddNode( RootNode, INDEX_NONE );
+	}
+	else
+	{
+		UE_LOG( LogFact, Warning, TEXT( "Root fact tag is not registered, fact index is empty" ) );
+	}
+
+#if WITH_EDITOR
+	UGameplayTagsManager::OnEditorRefreshGameplayTagTree.AddRaw( this, &FFactTagIndex::HandleTagTreeRefreshed );
+#endif
+}
+
+int32 FFactTagIndex::Find( const FGameplayTag Tag ) const
+{
+	if ( IsInGameThread() == false )
+	{
+		FReadScopeLock ReadLock( Lock );
+		const int32* Index = TagToIndex.Find( Tag );
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	const int32* Index = TagToIndex.Find( Tag );
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 FFactTagIndex::FindByName( const FName TagName, FFactTag& OutTag ) const
+{
+	auto FindIndex = [ this, TagName, &OutTag ]()
+	{
+		const int32* Index = NameToIndex.Find( TagName );
+		OutTag = Index ? Tags[ *Index ] : FFactTag();
+		return Index ? *Index : INDEX_NONE;
+	};
+
+	if ( IsInGameThread() == false )
+	{
+		FReadScopeLock ReadLock( Lock );
+		return FindIndex();
+	}
+
+	return FindIndex();
+}
+
+int32 FFactTagIndex::FindOrAdd( const FGameplayTag Tag )
+{
+	if ( const int32* Index = TagToIndex.Find( Tag ) )
+	{
+		return *Index;
+	}
+
+	const FFactTag FactTag = FFactTag::TryConvert( Tag );
+	if ( FactTag.IsValid() == false )
+	{
+		return INDEX_NONE;
+	}
+
+	// parent must be registered first, root "Fact" tag has no parent
+	const FGameplayTag ParentTag = FactTag.RequestDirectParent();
+	const int32 ParentIndex = ParentTag.IsValid() ? FindOrAdd( ParentTag ) : INDEX_NONE;
+
+	return AddTag( FactTag, ParentIndex );
+}
+
+void FFactTagIndex::AddNode( const TSharedPtr< FGameplayTagNode >& Node, int32 ParentIndex )
+{
+	const FFactTag Tag = FFactTag::ConvertChecked( Node->GetCompleteTag() );
+
+	const int32* ExistingIndex = TagToIndex.Find( Tag );
+	const int32 Index = ExistingIndex ? *ExistingIndex : AddTag( Tag, ParentIndex );
+
+	for ( const TSharedPtr< FGameplayTagNode >& ChildNode : Node->GetChildTagNodes() )
+	{
+		AddNode( ChildNode, Index );
+	}
+}
+
+int32 FFactTagIndex::AddTag( const FFactTag Tag, int32 ParentIndex )
+{
+	check( IsInGameThread() );
+
+	FWriteScopeLock WriteLock( Lock );
+	const int32 Index = Tags.Add( Tag );
+	Parents.Add( ParentIndex );
+	// FName hashes differ between processes, so signature is computed from tag names
+	Signatures.Add( FCrc::StrCrc32( *Tag.ToString(), GetSignature( Index ) ) );
+
+	FirstChildren.Add( INDEX_NONE );
+	LastChildren.Add( INDEX_NONE );
+	NextSiblings.Add( INDEX_NONE );
+	if ( ParentIndex != INDEX_NONE )
+	{
+		if ( LastChildren[ ParentIndex ] == INDEX_NONE )
+		{
+			FirstChildren[ ParentIndex ] = Index;
+		}
+		else
+		{
+			NextSiblings[ LastChildren[ ParentIndex ] ] = Index;
+		}
+		LastChildren[ ParentIndex ] = Index;
+	}
+
+	// tags are appended rarely (mostly in editor), so order is just rebuilt on next query
+	TreeOrder.Reset();
+	TagToIndex.Add( Tag, Index );
+	NameToIndex.Add( Tag.GetTagName(), Index );
+
+	return Index;
+}
+
+TConstArrayView< int32 > FFactTagIndex::GetSubtree( int32 Index ) const
+{
+	check( IsInGameThread() );
+
+	if ( TreeOrder.Num() != Tags.Num() )
+	{
+		RebuildTreeOrder();
+	}
+
+	return MakeArrayView( TreeOrder.GetData() + TreePositions[ Index ], SubtreeSizes[ Index ] );
+}
+
+void FFactTagIndex::RebuildTreeOrder() const
+{
+	TreeOrder.Reset( Tags.Num() );
+	TreePositions.SetNumUninitialized( Tags.Num() );
+	SubtreeSizes.SetNumUninitialized( Tags.Num() );
+
+	for ( int32 Index = 0; Index < Tags.Num(); ++Index )
+	{
+		if ( Parents[ Index ] == INDEX_NONE )
+		{
+			AddToTreeOrder( Index );
+		}
+	}
+}
+
+void FFactTagIndex::AddToTreeOrder( int32 Index ) const
+{
+	const int32 Position = TreeOrder.Add( Index );
+	TreePositions[ Index ] = Position;
+
+	for ( int32 Child = FirstChildren[ Index ]; Child != INDEX_NONE; Child = NextSiblings[ Child ] )
+	{
+		AddToTreeOrder( Child );
+	}
+
+	SubtreeSizes[ Index ] = TreeOrder.Num() - Position;
+}
+
+#if WITH_EDITOR
+void FFactTagIndex::HandleTagTreeRefreshed()
+{
+	// only append new tags, removed ones stay in index, so already resolved indices are not invalidated
+	const TSharedPtr< FGameplayTagNode > RootNode = UGameplayTagsManager::Get().FindTagNode( FFactTag::GetRootTag() );
+	if ( RootNode.IsValid() )
+	{
+		AddNode( RootNode, INDEX_NONE );
+	}
+}
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactThresholds.h"
+
+#include "Algo/BinarySearch.h"
+
+FFactThresholdHandle FFactThresholds::Add( int32 FactIndex, int32 Threshold, FFactThresholdCrossed::FDelegate&& Delegate )
+{
+	if ( FactIndex >= ThresholdsByFact.Num() )
+	{
+		ThresholdsByFact.SetNum( FactIndex + 1 );
+	}
+	TArray< FThreshold >& Thresholds = ThresholdsByFact[ FactIndex ];
+	++NumThresholds;
+
+	// thresholds with the same value keep registration order
+	const int32 InsertIndex = Algo::UpperBoundBy( Thresholds, Threshold, &FThreshold::Value );
+
+	FThreshold& NewThreshold = Thresholds.InsertDefaulted_GetRef( InsertIndex );
+	NewThreshold.Value = Threshold;
+	NewThreshold.Id = ++LastId;
+	NewThreshold.Delegate = MoveTemp( Delegate );
+
+	FFactThresholdHandle Handle;
+	Handle.FactIndex = FactIndex;
+	Handle.Id = NewThreshold.Id;
+	return Handle;
+}
+
+void FFactThresholds::Remove( FFactThresholdHandle& Handle )
+{
+	if ( Handle.IsValid() && ThresholdsByFact.IsValidIndex( Handle.FactIndex ) )
+	{
+		TArray< FThreshold >& Thresholds = ThresholdsByFact[ Handle.FactIndex ];
+		const int32 Index = Thresholds.IndexOfByPredicate( [ &Handle ]( const FThreshold& Threshold ) { return Threshold.Id == Handle.Id; } );
+		if ( Index != INDEX_NONE )
+		{
+			// queued crossings of removed threshold are skipped on dispatch
+			Thresholds.RemoveAt( Index );
+			--NumThresholds;
+		}
+	}
+
+	Handle.Reset();
+}
+
+void FFactThresholds::OnFactChanged( int32 FactIndex, const int32* OldValue, const int32* NewValue )
+{
+	const TArray< FThreshold >* Thresholds = FindThresholds( FactIndex );
+	if ( Thresholds == nullptr )
+	{
+		return;
+	}
+
+	const int32 Old = OldValue != nullptr ? *OldValue : 0;
+	const int32 New = NewValue != nullptr ? *NewValue : 0;
+	if ( Old == New )
+	{
+		return;
+	}
+
+	// threshold T is reached while value >= T, so crossed thresholds are the ones in ( Min, Max ]
+	const bool bReached = New > Old;
+	const int32 First = Algo::UpperBoundBy( *Thresholds, FMath::Min( Old, New ), &FThreshold::Value );
+	const int32 Last = Algo::UpperBoundBy( *Thresholds, FMath::Max( Old, New ), &FThreshold::Value );
+
+	// crossings are queued in the order, in which value passes thresholds
+	for ( int32 Offset = 0; Offset < Last - First; ++Offset )
+	{
+		const FThreshold& Threshold = ( *Thresholds )[ bReached ? First + Offset : Last - 1 - Offset ];
+		PendingCrossings.Add( { FactIndex, Threshold.Value, Threshold.Id, bReached } );
+	}
+}
+
+void FFactThresholds::Dispatch()
+{
+	// delegates can change facts (which queues more crossings) or add/remove thresholds, so work on a local copy
+	while ( PendingCrossings.Num() )
+	{
+		TArray< FCrossing > Crossings = MoveTemp( PendingCrossings );
+		for ( const FCrossing& Crossing : Crossings )
+		{
+			const FThreshold* Threshold = Find( Crossing.FactIndex, Crossing.Value, Crossing.Id );
+			if ( Threshold == nullptr )
+			{
+				continue;
+			}
+
+			// delegate is copied, because thresholds can be reallocated while it is executed
+			const FFactThresholdCrossed::FDelegate Delegate = Threshold->Delegate;
+			Delegate.ExecuteIfBound( Crossing.bReached );
+		}
+	}
+}
+
+const FFactThresholds::FThreshold* FFactThresholds::Find( int32 FactIndex, int32 Value, uint32 Id ) const
+{
+	const TArray< FThreshold >* Thresholds = FindThresholds( FactIndex );
+	if ( Thresholds == nullptr )
+	{
+		return nullptr;
+	}
+
+	for ( int32 Index = Algo::LowerBoundBy( *Thresholds, Value, &FThreshold::Value ); Index < Thresholds->Num() && ( *Thresholds )[ Index ].Value == Value; ++Index )
+	{
+		if ( ( *Thresholds )[ Index ].Id == Id )
+		{
+			return &( *Thresholds )[ Index ];
+		}
+	}
+
+	return nullptr;
+}
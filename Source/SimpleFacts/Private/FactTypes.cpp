@@ -3,8 +3,24 @@
 #include "FactTypes.h"
 
 #include "FactSubsystem.h"
+#include "FactTagIndex.h"
 #include "Kismet/GameplayStatics.h"
 
+FFactHandle FFactHandle::Resolve( const FGameplayTag Tag )
+{
+	return FFactHandle( FFactTagIndex::Get().FindOrAdd( Tag ) );
+}
+
+FFactHandle FFactHandle::Find( const FGameplayTag Tag )
+{
+	return FFactHandle( FFactTagIndex::Get().Find( Tag ) );
+}
+
+FFactTag FFactHandle::GetTag() const
+{
+	return IsValid() ? FFactTagIndex::Get().GetTag( Index ) : FFactTag();
+}
+
 bool FFactCondition::CheckValue( const UFactSubsystem& FactSubsystem ) const
 {
 	return FactSubsystem.CheckFactCondition( *this );
@@ -15,6 +31,16 @@ bool FFactCondition::IsValid() const
 	return Tag.IsValid();
 }
 
+FFactHandle FFactCondition::GetHandle() const
+{
+	if ( CachedHandle.IsValid() == false || CachedHandle.GetTag() != Tag )
+	{
+		CachedHandle = FFactHandle::Resolve( Tag );
+	}
+
+	return CachedHandle;
+}
+
 FString FFactCondition::ToString() const
 {
 	return FString::Format( TEXT( "{0} {1} {2}" ), { Tag.ToString()
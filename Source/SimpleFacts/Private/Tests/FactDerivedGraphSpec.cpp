@@ -0,0 +1,141 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactDerivedGraph.h"
+#include "FactStorage.h"
+#include "FactTagIndex.h"
+#include "FactTestUtils.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FactDerivedGraphSpec
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_A, "Fact.Tests.Derived.A" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_B, "Fact.Tests.Derived.B" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Middle, "Fact.Tests.Derived.Middle" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Top, "Fact.Tests.Derived.Top" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_CycleFirst, "Fact.Tests.Derived.CycleFirst" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_CycleSecond, "Fact.Tests.Derived.CycleSecond" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Downstream, "Fact.Tests.Derived.Downstream" );
+
+	using namespace FactTestUtils;
+
+	FFactDerivedDefinition MakeSum( const FNativeGameplayTag& Tag, std::initializer_list< const FNativeGameplayTag* > Sources )
+	{
+		FFactDerivedDefinition Definition;
+		Definition.Tag = GetTag( Tag );
+		Definition.Operation = EFactDerivedOperation::Sum;
+		for ( const FNativeGameplayTag* Source : Sources )
+		{
+			Definition.Sources.Add( GetTag( *Source ) );
+		}
+		return Definition;
+	}
+}
+
+BEGIN_DEFINE_SPEC( FFactDerivedGraphSpec, "SimpleFacts.DerivedGraph", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter )
+	TUniquePtr< FFactDerivedGraph > Graph;
+	FFactStorage Storage;
+	// Derived facts in order, in which they were written
+	TArray< int32 > Written;
+
+	void Update()
+	{
+		Graph->Update( Storage, [ this ]( int32 FactIndex, int32 Value )
+		{
+			Written.Add( FactIndex );
+			Storage.Set( FactIndex, Value );
+			Graph->MarkDirty( FactIndex );
+		} );
+	}
+
+	void ChangeFact( const FNativeGameplayTag& Tag, int32 Value )
+	{
+		const int32 Index = FactTestUtils::Resolve( Tag );
+		Storage.Set( Index, Value );
+		Graph->MarkDirty( Index );
+	}
+
+	void TestValue( const FNativeGameplayTag& Tag, int32 Expected )
+	{
+		const int32* Value = Storage.Find( FactTestUtils::Resolve( Tag ) );
+		if ( TestNotNull( *FString::Printf( TEXT( "Fact %s is defined" ), *Tag.GetTag().ToString() ), Value ) )
+		{
+			TestEqual( *FString::Printf( TEXT( "Value of %s" ), *Tag.GetTag().ToString() ), *Value, Expected );
+		}
+	}
+END_DEFINE_SPEC( FFactDerivedGraphSpec )
+
+void FFactDerivedGraphSpec::Define()
+{
+	using namespace FactDerivedGraphSpec;
+
+	BeforeEach( [ this ]()
+	{
+		ResolveAll( { &TAG_A, &TAG_B, &TAG_Middle, &TAG_Top, &TAG_CycleFirst, &TAG_CycleSecond, &TAG_Downstream } );
+
+		Storage.Reset( FFactTagIndex::Get().Num() );
+		Storage.Set( Resolve( TAG_A ), 1 );
+		Storage.Set( Resolve( TAG_B ), 2 );
+		Written.Reset();
+
+		// dependent fact is defined before its source, so graph has to reorder them
+		Graph = MakeUnique< FFactDerivedGraph >();
+		Graph->Add( { MakeSum( TAG_Top, { &TAG_Middle, &TAG_A } ), MakeSum( TAG_Middle, { &TAG_A, &TAG_B } ) } );
+	} );
+
+	AfterEach( [ this ]()
+	{
+		Graph.Reset();
+	} );
+
+	It( "should compute derived facts after their sources", [ this ]()
+	{
+		Update();
+
+		TestTrue( TEXT( "Facts are written in dependency order" ), Written == TArray< int32 >{ Resolve( TAG_Middle ), Resolve( TAG_Top ) } );
+		TestValue( TAG_Middle, 3 );
+		TestValue( TAG_Top, 4 );
+	} );
+
+	It( "should recompute each dependent fact once per change", [ this ]()
+	{
+		Update();
+		Written.Reset();
+
+		ChangeFact( TAG_A, 5 );
+		ChangeFact( TAG_B, 10 );
+		Update();
+
+		TestTrue( TEXT( "Facts are written in dependency order" ), Written == TArray< int32 >{ Resolve( TAG_Middle ), Resolve( TAG_Top ) } );
+		TestValue( TAG_Middle, 15 );
+		TestValue( TAG_Top, 20 );
+	} );
+
+	It( "should restore derived fact, that was changed directly", [ this ]()
+	{
+		Update();
+
+		ChangeFact( TAG_Middle, 100 );
+		TestTrue( TEXT( "Graph has dirty nodes" ), Graph->HasDirtyNodes() );
+		Update();
+
+		TestValue( TAG_Middle, 3 );
+		TestValue( TAG_Top, 4 );
+	} );
+
+	It( "should skip only facts, that form cycle or depend on it", [ this ]()
+	{
+		AddExpectedError( TEXT( "depends on itself" ), EAutomationExpectedErrorFlags::Contains, 2 );
+		AddExpectedError( TEXT( "depends on derived facts, that form a cycle" ), EAutomationExpectedErrorFlags::Contains, 1 );
+
+		Graph->Add( { MakeSum( TAG_CycleFirst, { &TAG_CycleSecond } ), MakeSum( TAG_CycleSecond, { &TAG_CycleFirst } ), MakeSum( TAG_Downstream, { &TAG_CycleFirst } ) } );
+
+		TestFalse( TEXT( "First fact of cycle is derived" ), Graph->IsDerived( Resolve( TAG_CycleFirst ) ) );
+		TestFalse( TEXT( "Second fact of cycle is derived" ), Graph->IsDerived( Resolve( TAG_CycleSecond ) ) );
+		TestFalse( TEXT( "Fact, that depends on cycle, is derived" ), Graph->IsDerived( Resolve( TAG_Downstream ) ) );
+		TestTrue( TEXT( "Fact outside of cycle is derived" ), Graph->IsDerived( Resolve( TAG_Top ) ) );
+	} );
+}
+
+#endif
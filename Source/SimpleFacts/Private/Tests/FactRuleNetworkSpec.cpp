@@ -0,0 +1,133 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactRuleNetwork.h"
+#include "FactRules.h"
+#include "FactStorage.h"
+#include "FactTagIndex.h"
+#include "FactTestUtils.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FactRuleNetworkSpec
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_A, "Fact.Tests.Rules.A" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_B, "Fact.Tests.Rules.B" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_C, "Fact.Tests.Rules.C" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_D, "Fact.Tests.Rules.D" );
+
+	using namespace FactTestUtils;
+
+	// Rule "when Condition == ConditionValue, set Action = ActionValue"
+	FFactRule MakeRule( FName Name, const FNativeGameplayTag& Condition, int32 ConditionValue, const FNativeGameplayTag& Action, int32 ActionValue )
+	{
+		FFactRule Rule;
+		Rule.Name = Name;
+
+		FFactCondition& RuleCondition = Rule.Conditions.AddDefaulted_GetRef();
+		RuleCondition.Tag = GetTag( Condition );
+		RuleCondition.Operator = EFactCompareOperator::Equals;
+		RuleCondition.WantedValue = ConditionValue;
+
+		FFactRuleAction& RuleAction = Rule.Actions.AddDefaulted_GetRef();
+		RuleAction.Tag = GetTag( Action );
+		RuleAction.ChangeType = EFactValueChangeType::Set;
+		RuleAction.Value = ActionValue;
+		return Rule;
+	}
+}
+
+BEGIN_DEFINE_SPEC( FFactRuleNetworkSpec, "SimpleFacts.RuleNetwork", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter )
+	TUniquePtr< FFactRuleNetwork > Network;
+	FFactStorage Storage;
+	TArray< FName > FiredRules;
+	TArray< FName > RejectedRules;
+
+	void ChangeFact( const FNativeGameplayTag& Tag, int32 Value )
+	{
+		const int32 Index = FactTestUtils::Resolve( Tag );
+		Storage.Set( Index, Value );
+		Network->OnFactChanged( Index, Storage, true );
+	}
+
+	// Same loop as UFactSubsystem::FireFactRules, but without chain depth limit
+	void FireRules()
+	{
+		FFactRuleNetwork::FActivation Activation;
+		while ( Network->PopActivation( Activation ) )
+		{
+			if ( Network->BeginFiring( Activation ) == false )
+			{
+				RejectedRules.Add( Network->GetRuleName( Activation.RuleIndex ) );
+				continue;
+			}
+
+			FiredRules.Add( Network->GetRuleName( Activation.RuleIndex ) );
+			for ( const FFactRuleNetwork::FAction& Action : Network->GetActions( Activation.RuleIndex ) )
+			{
+				Storage.Set( Action.FactIndex, Action.Value );
+				Network->OnFactChanged( Action.FactIndex, Storage, true );
+			}
+			Network->EndFiring();
+		}
+	}
+
+	void TestRules( const TCHAR* What, const TArray< FName >& Actual, const TArray< FName >& Expected )
+	{
+		TestEqual( What, FString::JoinBy( Actual, TEXT( ", " ), UE_PROJECTION_MEMBER( FName, ToString ) ), FString::JoinBy( Expected, TEXT( ", " ), UE_PROJECTION_MEMBER( FName, ToString ) ) );
+	}
+END_DEFINE_SPEC( FFactRuleNetworkSpec )
+
+void FFactRuleNetworkSpec::Define()
+{
+	using namespace FactRuleNetworkSpec;
+
+	BeforeEach( [ this ]()
+	{
+		ResolveAll( { &TAG_A, &TAG_B, &TAG_C, &TAG_D } );
+
+		Storage.Reset( FFactTagIndex::Get().Num() );
+		Network = MakeUnique< FFactRuleNetwork >();
+		FiredRules.Reset();
+		RejectedRules.Reset();
+	} );
+
+	AfterEach( [ this ]()
+	{
+		Network.Reset();
+	} );
+
+	It( "should stop cycle, when rule is activated again by its own chain", [ this ]()
+	{
+		// Off and On keep toggling A, so On is activated again by chain, that it has started
+		Network->Add( { MakeRule( TEXT( "On" ), TAG_A, 1, TAG_A, 0 ), MakeRule( TEXT( "Off" ), TAG_A, 0, TAG_A, 1 ) }, FObjectKey(), Storage );
+
+		ChangeFact( TAG_A, 1 );
+		FireRules();
+
+		TestRules( TEXT( "Fired rules" ), FiredRules, { TEXT( "On" ), TEXT( "Off" ) } );
+		TestRules( TEXT( "Rejected rules" ), RejectedRules, { TEXT( "On" ) } );
+		TestFalse( TEXT( "Network has activations" ), Network->HasActivations() );
+	} );
+
+	It( "should fire the same rule from independent chains", [ this ]()
+	{
+		// Reset is fired by chain of SetFromA and then again by chain of SetFromB -> SetFromD
+		Network->Add(
+		{
+			MakeRule( TEXT( "SetFromA" ), TAG_A, 1, TAG_C, 1 ),
+			MakeRule( TEXT( "SetFromB" ), TAG_B, 1, TAG_D, 1 ),
+			MakeRule( TEXT( "SetFromD" ), TAG_D, 1, TAG_C, 1 ),
+			MakeRule( TEXT( "Reset" ), TAG_C, 1, TAG_C, 0 ),
+		}, FObjectKey(), Storage );
+
+		ChangeFact( TAG_A, 1 );
+		ChangeFact( TAG_B, 1 );
+		FireRules();
+
+		TestRules( TEXT( "Fired rules" ), FiredRules, { TEXT( "SetFromA" ), TEXT( "SetFromB" ), TEXT( "Reset" ), TEXT( "SetFromD" ), TEXT( "Reset" ) } );
+		TestRules( TEXT( "Rejected rules" ), RejectedRules, {} );
+	} );
+}
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactSaveFormat.h"
+#include "FactTagIndex.h"
+#include "FactTestUtils.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FactSaveFormatSpec
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Small, "Fact.Tests.SaveFormat.Small" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Negative, "Fact.Tests.SaveFormat.Negative" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Max, "Fact.Tests.SaveFormat.Max" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Min, "Fact.Tests.SaveFormat.Min" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Delta, "Fact.Tests.SaveFormat.Delta" );
+
+	// Values around boundaries of varint bytes and of zig-zag sign folding
+	const TPair< FNativeGameplayTag*, int32 > SavedFacts[] =
+	{
+		{ &TAG_Small, 63 },
+		{ &TAG_Negative, -64 },
+		{ &TAG_Max, MAX_int32 },
+		{ &TAG_Min, MIN_int32 },
+		{ &TAG_Delta, 0 },
+	};
+}
+
+BEGIN_DEFINE_SPEC( FFactSaveFormatSpec, "SimpleFacts.SaveFormat", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter )
+	TArray< uint8 > Bytes;
+END_DEFINE_SPEC( FFactSaveFormatSpec )
+
+void FFactSaveFormatSpec::Define()
+{
+	using namespace FactSaveFormatSpec;
+	using namespace FactTestUtils;
+
+	BeforeEach( [ this ]()
+	{
+		FactSaveFormat::FWriter Writer;
+		for ( const TPair< FNativeGameplayTag*, int32 >& Fact : SavedFacts )
+		{
+			Resolve( *Fact.Key );
+			Writer.Add( GetTag( *Fact.Key ), Fact.Value );
+		}
+		Writer.Finish( Bytes );
+	} );
+
+	It( "should read back every written value", [ this ]()
+	{
+		TMap< int32, int32 > ReadFacts;
+		const bool bSuccess = FactSaveFormat::Read( Bytes, FFactTagIndex::Get(), [ &ReadFacts ]( const FName, int32 Index, int32 Value )
+		{
+			ReadFacts.Add( Index, Value );
+		} );
+
+		TestTrue( TEXT( "Read succeeded" ), bSuccess );
+		TestEqual( TEXT( "Number of read facts" ), ReadFacts.Num(), static_cast< int32 >( UE_ARRAY_COUNT( SavedFacts ) ) );
+		for ( const TPair< FNativeGameplayTag*, int32 >& Fact : SavedFacts )
+		{
+			const int32* Value = ReadFacts.Find( Resolve( *Fact.Key ) );
+			if ( TestNotNull( *FString::Printf( TEXT( "Fact %s was read" ), *GetTag( *Fact.Key ).ToString() ), Value ) )
+			{
+				TestEqual( *FString::Printf( TEXT( "Value of %s" ), *GetTag( *Fact.Key ).ToString() ), *Value, Fact.Value );
+			}
+		}
+	} );
+
+	It( "should fail on truncated data", [ this ]()
+	{
+		Bytes.SetNum( Bytes.Num() - 1 );
+
+		AddExpectedError( TEXT( "Saved facts are corrupted" ) );
+		const bool bSuccess = FactSaveFormat::Read( Bytes, FFactTagIndex::Get(), []( const FName, int32, int32 ) {} );
+		TestFalse( TEXT( "Read succeeded" ), bSuccess );
+	} );
+
+	It( "should fail on delta with mismatched values", [ this ]()
+	{
+		FFactSaveImage Image;
+		Image.PackedFacts = Bytes;
+
+		FFactSaveDelta Delta;
+		Delta.Tags.Add( GetTag( TAG_Delta ) );
+		Delta.Tags.Add( GetTag( TAG_Small ) );
+		Delta.Values.Add( 300 );
+
+		AddExpectedError( TEXT( "Saved facts are corrupted" ) );
+		const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+		const FFactLoadResult Result = FactSaveFormat::Decode( Image, MakeArrayView( &Delta, 1 ), TagIndex, TagIndex.Num() );
+		TestFalse( TEXT( "Decode succeeded" ), Result.bSuccess );
+	} );
+
+	It( "should decode compressed image with deltas on top", [ this ]()
+	{
+		FFactSaveImage Image;
+		Image.PackedFacts = Bytes;
+		FactSaveFormat::Compress( Image );
+
+		FFactSaveDelta Delta;
+		Delta.Tags.Add( GetTag( TAG_Delta ) );
+		Delta.Values.Add( 300 );
+		Delta.UndefinedTags.Add( GetTag( TAG_Small ) );
+
+		const FFactTagIndex& TagIndex = FFactTagIndex::Get();
+		const FFactLoadResult Result = FactSaveFormat::Decode( Image, MakeArrayView( &Delta, 1 ), TagIndex, TagIndex.Num() );
+
+		TestTrue( TEXT( "Decode succeeded" ), Result.bSuccess );
+		TestNull( TEXT( "Fact, undefined by delta" ), Result.Facts.Find( Resolve( TAG_Small ) ) );
+		TestTrue( TEXT( "Undefined fact is reported" ), Result.UndefinedFacts.Contains( GetTag( TAG_Small ) ) );
+
+		const int32* DeltaValue = Result.Facts.Find( Resolve( TAG_Delta ) );
+		if ( TestNotNull( TEXT( "Fact, overridden by delta" ), DeltaValue ) )
+		{
+			TestEqual( TEXT( "Value of fact, overridden by delta" ), *DeltaValue, 300 );
+		}
+
+		const int32* MinValue = Result.Facts.Find( Resolve( TAG_Min ) );
+		if ( TestNotNull( TEXT( "Fact from base image" ), MinValue ) )
+		{
+			TestEqual( TEXT( "Value of fact from base image" ), *MinValue, MIN_int32 );
+		}
+	} );
+}
+
+#endif
@@ -0,0 +1,130 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactSnapshot.h"
+#include "FactStorage.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FactSnapshotSpec
+{
+	// Enough facts for two pages of chunks, so both shared and copied pages are visited
+	constexpr int32 NumFacts = ( FFactSnapshotChunkPage::NumChunks + 2 ) * FFactStorage::ChunkSize;
+
+	struct FDifference
+	{
+		int32 Index = INDEX_NONE;
+		TOptional< int32 > From;
+		TOptional< int32 > To;
+	};
+
+	TArray< FDifference > CollectDifferences( const FFactSnapshot& From, const FFactSnapshot& To )
+	{
+		TArray< FDifference > Differences;
+		FFactSnapshot::ForEachDifference( From, To, [ &Differences ]( int32 Index, const int32* FromValue, const int32* ToValue )
+		{
+			FDifference& Difference = Differences.AddDefaulted_GetRef();
+			Difference.Index = Index;
+			Difference.From = FromValue != nullptr ? TOptional< int32 >( *FromValue ) : TOptional< int32 >();
+			Difference.To = ToValue != nullptr ? TOptional< int32 >( *ToValue ) : TOptional< int32 >();
+		} );
+		return Differences;
+	}
+}
+
+BEGIN_DEFINE_SPEC( FFactSnapshotSpec, "SimpleFacts.Snapshot", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter )
+	FFactStorage Storage;
+	TUniquePtr< FFactSnapshotPublisher > Publisher;
+	FFactSnapshotPtr Checkpoint;
+
+	void TestDifference( const FactSnapshotSpec::FDifference& Difference, int32 Index, TOptional< int32 > From, TOptional< int32 > To )
+	{
+		TestEqual( TEXT( "Index of changed fact" ), Difference.Index, Index );
+		TestTrue( *FString::Printf( TEXT( "Old value of fact %d" ), Index ), Difference.From == From );
+		TestTrue( *FString::Printf( TEXT( "New value of fact %d" ), Index ), Difference.To == To );
+	}
+END_DEFINE_SPEC( FFactSnapshotSpec )
+
+void FFactSnapshotSpec::Define()
+{
+	using namespace FactSnapshotSpec;
+
+	BeforeEach( [ this ]()
+	{
+		Storage.Reset( NumFacts );
+		Storage.Set( 1, 10 );
+		Storage.Set( FFactStorage::ChunkSize + 5, 20 );
+		Storage.Set( NumFacts - 1, 30 );
+
+		Publisher = MakeUnique< FFactSnapshotPublisher >();
+		Publisher->Publish( Storage );
+		Checkpoint = Publisher->GetLatest();
+	} );
+
+	AfterEach( [ this ]()
+	{
+		Checkpoint.Reset();
+		Publisher.Reset();
+	} );
+
+	It( "should report no differences without changes", [ this ]()
+	{
+		Publisher->Publish( Storage );
+		TestTrue( TEXT( "Snapshot is reused" ), Publisher->GetLatest() == Checkpoint );
+		TestEqual( TEXT( "Number of differences" ), CollectDifferences( *Checkpoint, *Publisher->GetLatest() ).Num(), 0 );
+	} );
+
+	It( "should report changed, defined and undefined facts in index order", [ this ]()
+	{
+		Storage.Set( 1, 11 );
+		Storage.Set( 2, 0 );
+		Storage.Undefine( NumFacts - 1 );
+		Publisher->Publish( Storage );
+
+		const TArray< FDifference > Differences = CollectDifferences( *Checkpoint, *Publisher->GetLatest() );
+		if ( TestEqual( TEXT( "Number of differences" ), Differences.Num(), 3 ) )
+		{
+			TestDifference( Differences[ 0 ], 1, 10, 11 );
+			TestDifference( Differences[ 1 ], 2, {}, 0 );
+			TestDifference( Differences[ 2 ], NumFacts - 1, 30, {} );
+		}
+	} );
+
+	It( "should keep checkpoint unchanged after publishing newer state", [ this ]()
+	{
+		Storage.Set( FFactStorage::ChunkSize + 5, 21 );
+		Publisher->Publish( Storage );
+
+		const int32* Value = Checkpoint->Find( FFactStorage::ChunkSize + 5 );
+		if ( TestNotNull( TEXT( "Fact in checkpoint" ), Value ) )
+		{
+			TestEqual( TEXT( "Value of fact in checkpoint" ), *Value, 20 );
+		}
+	} );
+
+	It( "should report facts of chunks, added by growing storage", [ this ]()
+	{
+		Storage.Set( NumFacts + FFactStorage::ChunkSize, 40 );
+		Publisher->Publish( Storage );
+
+		const TArray< FDifference > Differences = CollectDifferences( *Checkpoint, *Publisher->GetLatest() );
+		if ( TestEqual( TEXT( "Number of differences" ), Differences.Num(), 1 ) )
+		{
+			TestDifference( Differences[ 0 ], NumFacts + FFactStorage::ChunkSize, {}, 40 );
+		}
+	} );
+
+	It( "should report differences in both directions", [ this ]()
+	{
+		Storage.Set( 1, 12 );
+		Publisher->Publish( Storage );
+
+		const TArray< FDifference > Differences = CollectDifferences( *Publisher->GetLatest(), *Checkpoint );
+		if ( TestEqual( TEXT( "Number of differences" ), Differences.Num(), 1 ) )
+		{
+			TestDifference( Differences[ 0 ], 1, 12, 10 );
+		}
+	} );
+}
+
+#endif
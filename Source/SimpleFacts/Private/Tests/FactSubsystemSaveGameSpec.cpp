@@ -0,0 +1,128 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactSubsystem.h"
+#include "FactTestUtils.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Subsystems/SubsystemCollection.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FactSubsystemSaveGameSpec
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_A, "Fact.Tests.SaveGame.A" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_B, "Fact.Tests.SaveGame.B" );
+	UE_DEFINE_GAMEPLAY_TAG_STATIC( TAG_Undefined, "Fact.Tests.SaveGame.Undefined" );
+
+	using namespace FactTestUtils;
+}
+
+BEGIN_DEFINE_SPEC( FFactSubsystemSaveGameSpec, "SimpleFacts.Subsystem.SaveGame", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter )
+	FSubsystemCollection< UGameInstanceSubsystem > Collection;
+	TArray< UFactSubsystem* > Subsystems;
+
+	UFactSubsystem* CreateSubsystem()
+	{
+		// not owned by game instance, so it's kept alive by root set until AfterEach
+		UFactSubsystem* Subsystem = NewObject< UFactSubsystem >();
+		Subsystem->AddToRoot();
+		Subsystem->Initialize( Collection );
+		Subsystems.Add( Subsystem );
+		return Subsystem;
+	}
+
+	// Archives are set up the same way, as for SaveGame properties of save game objects
+	void SaveSubsystem( UFactSubsystem* Subsystem, TArray< uint8 >& Bytes )
+	{
+		FMemoryWriter Writer( Bytes, true );
+		FObjectAndNameAsStringProxyArchive Archive( Writer, true );
+		Archive.ArIsSaveGame = true;
+		Subsystem->Serialize( Archive );
+	}
+
+	void LoadSubsystem( UFactSubsystem* Subsystem, const TArray< uint8 >& Bytes )
+	{
+		FMemoryReader Reader( Bytes, true );
+		FObjectAndNameAsStringProxyArchive Archive( Reader, true );
+		Archive.ArIsSaveGame = true;
+		Subsystem->Serialize( Archive );
+	}
+
+	// Names are written by proxy archive as ANSI strings, so they can be found in serialized bytes
+	bool ContainsText( const TArray< uint8 >& Bytes, const ANSICHAR* Text )
+	{
+		const int32 Length = FCStringAnsi::Strlen( Text );
+		for ( int32 Offset = 0; Offset + Length <= Bytes.Num(); ++Offset )
+		{
+			if ( FMemory::Memcmp( Bytes.GetData() + Offset, Text, Length ) == 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void TestValue( UFactSubsystem* Subsystem, const FNativeGameplayTag& Tag, int32 Expected )
+	{
+		int32 Value = 0;
+		if ( TestTrue( *FString::Printf( TEXT( "Fact %s is defined" ), *Tag.GetTag().ToString() ), Subsystem->GetFactValueIfDefined( FactTestUtils::GetTag( Tag ), Value ) ) )
+		{
+			TestEqual( *FString::Printf( TEXT( "Value of %s" ), *Tag.GetTag().ToString() ), Value, Expected );
+		}
+	}
+END_DEFINE_SPEC( FFactSubsystemSaveGameSpec )
+
+void FFactSubsystemSaveGameSpec::Define()
+{
+	using namespace FactSubsystemSaveGameSpec;
+
+	BeforeEach( [ this ]()
+	{
+		ResolveAll( { &TAG_A, &TAG_B, &TAG_Undefined } );
+	} );
+
+	AfterEach( [ this ]()
+	{
+		for ( UFactSubsystem* Subsystem : Subsystems )
+		{
+			Subsystem->Deinitialize();
+			Subsystem->RemoveFromRoot();
+		}
+		Subsystems.Reset();
+	} );
+
+	It( "should restore defined facts from SaveGame properties", [ this ]()
+	{
+		UFactSubsystem* Saved = CreateSubsystem();
+		Saved->ChangeFactValue( GetTag( TAG_A ), 5, EFactValueChangeType::Set );
+		Saved->ChangeFactValue( GetTag( TAG_B ), -7, EFactValueChangeType::Set );
+
+		TArray< uint8 > Bytes;
+		SaveSubsystem( Saved, Bytes );
+
+		UFactSubsystem* Loaded = CreateSubsystem();
+		Loaded->ChangeFactValue( GetTag( TAG_Undefined ), 1, EFactValueChangeType::Set );
+		LoadSubsystem( Loaded, Bytes );
+
+		TestValue( Loaded, TAG_A, 5 );
+		TestValue( Loaded, TAG_B, -7 );
+		TestFalse( TEXT( "Fact, that wasn't saved, is defined" ), Loaded->IsFactDefined( GetTag( TAG_Undefined ) ) );
+	} );
+
+	It( "should keep facts serialized with names of their tags", [ this ]()
+	{
+		UFactSubsystem* Saved = CreateSubsystem();
+		Saved->ChangeFactValue( GetTag( TAG_A ), 5, EFactValueChangeType::Set );
+
+		TArray< uint8 > Bytes;
+		SaveSubsystem( Saved, Bytes );
+
+		// layout of older versions: tagged property with the same name, that holds names of fact tags
+		TestTrue( TEXT( "DefinedFacts property is written" ), ContainsText( Bytes, "DefinedFacts" ) );
+		TestTrue( TEXT( "Name of fact tag is written" ), ContainsText( Bytes, "Fact.Tests.SaveGame.A" ) );
+	} );
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+#include "NativeGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Helpers for specs, that declare their fact tags with UE_DEFINE_GAMEPLAY_TAG_STATIC
+namespace FactTestUtils
+{
+	inline FFactTag GetTag( const FNativeGameplayTag& NativeTag )
+	{
+		return FFactTag::TryConvert( NativeTag.GetTag() );
+	}
+
+	// Registers tag in FFactTagIndex, if it wasn't registered yet. @return index of fact
+	inline int32 Resolve( const FNativeGameplayTag& NativeTag )
+	{
+		return FFactHandle::Resolve( NativeTag.GetTag() ).GetIndex();
+	}
+
+	// Registers all tags up front, so storage can be sized for them
+	inline void ResolveAll( std::initializer_list< const FNativeGameplayTag* > NativeTags )
+	{
+		for ( const FNativeGameplayTag* NativeTag : NativeTags )
+		{
+			Resolve( *NativeTag );
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,109 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#include "FactThresholds.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC( FFactThresholdsSpec, "SimpleFacts.Thresholds", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter )
+	static constexpr int32 FactIndex = 3;
+
+	TUniquePtr< FFactThresholds > Thresholds;
+	// Crossings in order of dispatch as ( threshold, bReached )
+	TArray< TPair< int32, bool > > Crossings;
+
+	FFactThresholdHandle AddThreshold( int32 Value )
+	{
+		return Thresholds->Add( FactIndex, Value, FFactThresholdCrossed::FDelegate::CreateLambda( [ this, Value ]( bool bReached )
+		{
+			Crossings.Add( { Value, bReached } );
+		} ) );
+	}
+
+	void ChangeFact( const int32* OldValue, const int32* NewValue )
+	{
+		Thresholds->OnFactChanged( FactIndex, OldValue, NewValue );
+		Thresholds->Dispatch();
+	}
+
+	void ChangeFact( int32 OldValue, int32 NewValue )
+	{
+		ChangeFact( &OldValue, &NewValue );
+	}
+
+	void TestCrossings( std::initializer_list< TPair< int32, bool > > Expected )
+	{
+		if ( TestEqual( TEXT( "Number of crossings" ), Crossings.Num(), static_cast< int32 >( Expected.size() ) ) )
+		{
+			int32 Index = 0;
+			for ( const TPair< int32, bool >& Crossing : Expected )
+			{
+				TestEqual( *FString::Printf( TEXT( "Threshold of crossing %d" ), Index ), Crossings[ Index ].Key, Crossing.Key );
+				TestTrue( *FString::Printf( TEXT( "Direction of crossing %d" ), Index ), Crossings[ Index ].Value == Crossing.Value );
+				++Index;
+			}
+		}
+	}
+END_DEFINE_SPEC( FFactThresholdsSpec )
+
+void FFactThresholdsSpec::Define()
+{
+	BeforeEach( [ this ]()
+	{
+		Thresholds = MakeUnique< FFactThresholds >();
+		Crossings.Reset();
+
+		AddThreshold( 10 );
+		AddThreshold( 50 );
+		AddThreshold( 100 );
+	} );
+
+	AfterEach( [ this ]()
+	{
+		Thresholds.Reset();
+	} );
+
+	It( "should report reached thresholds in ascending order when value rises", [ this ]()
+	{
+		ChangeFact( 5, 50 );
+		TestCrossings( { { 10, true }, { 50, true } } );
+	} );
+
+	It( "should report lost thresholds in descending order when value drops", [ this ]()
+	{
+		ChangeFact( 120, 10 );
+		TestCrossings( { { 100, false }, { 50, false } } );
+	} );
+
+	It( "should not report thresholds, that weren't crossed", [ this ]()
+	{
+		ChangeFact( 11, 49 );
+		ChangeFact( 49, 11 );
+		TestCrossings( {} );
+	} );
+
+	It( "should treat undefined fact as 0", [ this ]()
+	{
+		const int32 Value = 10;
+		ChangeFact( nullptr, &Value );
+		ChangeFact( &Value, nullptr );
+		TestCrossings( { { 10, true }, { 10, false } } );
+	} );
+
+	It( "should skip removed thresholds", [ this ]()
+	{
+		FFactThresholdHandle Handle = AddThreshold( 20 );
+
+		// crossing of removed threshold is already queued
+		const int32 OldValue = 0;
+		const int32 NewValue = 30;
+		Thresholds->OnFactChanged( FactIndex, &OldValue, &NewValue );
+		Thresholds->Remove( Handle );
+		Thresholds->Dispatch();
+
+		TestFalse( TEXT( "Handle is valid after removal" ), Handle.IsValid() );
+		TestCrossings( { { 10, true } } );
+	} );
+}
+
+#endif
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FactListenerRegistry.h"
 #include "FactTypes.h"
 #include "Engine/CancellableAsyncAction.h"
 #include "AsyncAction_ListenForFactChanges.generated.h"
@@ -38,9 +39,9 @@ public:
 	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Became Defined"))
 	FAsyncFactDelegate OnFactBecameDefined;
 
-	// // Executes when fact state changes from defined to undefined. OnFactValueChanged will not be executed
-	// UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Became Undefined"))
-	// FAsyncFactDelegate OnFactBecameUndefined;
+	// Executes when fact state changes from defined to undefined. OnFactValueChanged will not be executed
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Became Undefined"))
+	FAsyncFactDelegate OnFactBecameUndefined;
 
 private:
 	UFUNCTION()
@@ -49,7 +50,16 @@ private:
 	UFUNCTION()
 	void HandleFactBecameDefined( int32 CurrentValue );
 
+	UFUNCTION()
+	void HandleFactBecameUndefined( int32 CurrentValue );
+
+	[[nodiscard]] bool IsAnyDelegateBound() const;
+
 private:
 	TWeakObjectPtr< UWorld > WorldPtr;
 	FFactTag Tag;
+
+	FFactListenerHandle ValueListenerHandle;
+	FFactListenerHandle DefinitionListenerHandle;
+	FFactListenerHandle UndefinitionListenerHandle;
 };
@@ -0,0 +1,46 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactListenerRegistry.h"
+#include "FactTypes.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "AsyncAction_ListenForFactSubtreeChanges.generated.h"
+
+/**
+ * 
+ */
+UCLASS()
+class SIMPLEFACTS_API UAsyncAction_ListenForFactSubtreeChanges : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Asynchronously waits for value change of a fact or any of its descendants.
+	 *
+	 * @param ParentTag			The Fact tag, which subtree to listen for
+	 */
+	UFUNCTION(BlueprintCallable, Category = Messaging, meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+	static UAsyncAction_ListenForFactSubtreeChanges* ListenForFactSubtreeChanges( UObject* WorldContextObject, FFactTag ParentTag );
+
+
+	virtual void Activate() override;
+	virtual void SetReadyToDestroy() override;
+
+public:
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( FAsyncFactSubtreeDelegate, FFactTag, ChangedTag, int32, CurrentValue );
+
+	// Executes when value of ParentTag fact or any of its descendants is changed
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Value Changed"))
+	FAsyncFactSubtreeDelegate OnFactValueChanged;
+
+private:
+	void HandleFactValueChanged( FFactTag ChangedTag, int32 CurrentValue );
+
+private:
+	TWeakObjectPtr< UWorld > WorldPtr;
+	FFactTag ParentTag;
+
+	FFactListenerHandle ListenerHandle;
+};
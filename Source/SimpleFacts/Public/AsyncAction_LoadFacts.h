@@ -0,0 +1,45 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "AsyncAction_LoadFacts.generated.h"
+
+class UFactSaveGame;
+
+/**
+ * 
+ */
+UCLASS()
+class SIMPLEFACTS_API UAsyncAction_LoadFacts : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Asynchronously loads facts from SaveGame. Facts are decoded on worker thread
+	 * and applied all at once right before Completed is executed.
+	 *
+	 * @param SaveGame			The SaveGame to read facts from
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+	static UAsyncAction_LoadFacts* LoadFactsAsync( UObject* WorldContextObject, const UFactSaveGame* SaveGame );
+
+
+	virtual void Activate() override;
+
+public:
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam( FAsyncLoadFactsDelegate, bool, bSuccess );
+
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Completed"))
+	FAsyncLoadFactsDelegate OnCompleted;
+
+private:
+	void HandleCompleted( bool bSuccess );
+
+private:
+	TWeakObjectPtr< UWorld > WorldPtr;
+
+	UPROPERTY()
+	const UFactSaveGame* SaveGame = nullptr;
+};
@@ -0,0 +1,45 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "AsyncAction_SaveFacts.generated.h"
+
+class UFactSaveGame;
+
+/**
+ * 
+ */
+UCLASS()
+class SIMPLEFACTS_API UAsyncAction_SaveFacts : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Asynchronously saves all facts into SaveGame. Facts are encoded and compressed on worker thread,
+	 * SaveGame is updated right before Completed is executed, so it should be written to slot only after that.
+	 *
+	 * @param SaveGame			The SaveGame to write facts into
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+	static UAsyncAction_SaveFacts* SaveFactsAsync( UObject* WorldContextObject, UFactSaveGame* SaveGame );
+
+
+	virtual void Activate() override;
+
+public:
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam( FAsyncSaveFactsDelegate, bool, bSuccess );
+
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Completed"))
+	FAsyncSaveFactsDelegate OnCompleted;
+
+private:
+	void HandleCompleted( bool bSuccess );
+
+private:
+	TWeakObjectPtr< UWorld > WorldPtr;
+
+	UPROPERTY()
+	UFactSaveGame* SaveGame = nullptr;
+};
@@ -0,0 +1,51 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactConditionWatchers.h"
+#include "FactExpression.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "AsyncAction_WatchFactExpression.generated.h"
+
+/**
+ * 
+ */
+UCLASS()
+class SIMPLEFACTS_API UAsyncAction_WatchFactExpression : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Asynchronously watches result of fact expression. Replaces polling of conditions on Tick:
+	 * expression is re-evaluated only when facts, that it reads, are changed.
+	 *
+	 * @param Expression			The Fact expression to watch
+	 */
+	UFUNCTION(BlueprintCallable, Category = Messaging, meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+	static UAsyncAction_WatchFactExpression* WatchFactExpression( UObject* WorldContextObject, const FFactExpression& Expression );
+
+
+	virtual void Activate() override;
+	virtual void SetReadyToDestroy() override;
+
+public:
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam( FAsyncFactExpressionDelegate, bool, bPasses );
+
+	// Executes once with initial result of expression right after activation
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Initial Result"))
+	FAsyncFactExpressionDelegate OnInitialResult;
+
+	// Executes every time result of expression flips
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "Result Changed"))
+	FAsyncFactExpressionDelegate OnResultChanged;
+
+private:
+	void HandleResultChanged( bool bPasses );
+
+private:
+	TWeakObjectPtr< UWorld > WorldPtr;
+	FFactExpression Expression;
+
+	FFactWatcherHandle WatcherHandle;
+};
@@ -0,0 +1,56 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactStorage.h"
+#include "FactAggregates.generated.h"
+
+// Aggregate over all defined facts of some fact subtree. Min and Max are 0, if there are no defined facts
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactAggregate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Fact")
+	int32 DefinedCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Fact")
+	int64 Sum = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Fact")
+	int32 Min = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Fact")
+	int32 Max = 0;
+};
+
+/**
+ * Aggregates (number of defined facts, sum, min and max of values) for every node of fact tag hierarchy over its whole subtree.
+ * Change of single fact updates all its ancestors in O(depth). Min or max, that can be lost by change (e.g. current minimum is increased),
+ * is only marked stale and is recomputed from subtree on next read, so reads are O(1) unless extreme value was just lost.
+ * Should be used only from game thread.
+ */
+class SIMPLEFACTS_API FFactAggregates
+{
+public:
+	// Recomputes aggregates of all nodes from storage
+	void Rebuild( const FFactStorage& Storage );
+
+	// Should be called for every change of fact in storage (value is nullptr if fact is undefined)
+	void OnFactChanged( int32 Index, const int32* OldValue, const int32* NewValue );
+
+	// @param Storage current facts, used only to recompute stale min or max
+	[[nodiscard]] FFactAggregate Get( int32 Index, const FFactStorage& Storage ) const;
+
+private:
+	struct FNode
+	{
+		FFactAggregate Aggregate;
+		bool bMinStale = false;
+		bool bMaxStale = false;
+	};
+
+	// Indexed by FFactTagIndex, stale extremes are recomputed on read
+	mutable TArray< FNode > Nodes;
+};
@@ -0,0 +1,47 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+
+// Single change of fact value. Value of undefined fact is 0
+struct FFactChangeRecord
+{
+	uint64 Sequence = 0;
+	FFactTag Tag;
+	int32 OldValue = 0;
+	int32 NewValue = 0;
+	double Timestamp = 0.0;
+};
+
+/**
+ * Fixed-capacity ring buffer of latest fact changes, ordered by sequence number (first change has sequence 1).
+ * Every record is stored twice (in the first and the second half of the buffer), so any range of retained records
+ * is contiguous in memory and can be returned as view without copying.
+ */
+class SIMPLEFACTS_API FFactChangeJournal
+{
+public:
+	// Drops all records and sets new capacity. Sequence numbers keep growing. Zero capacity disables journal
+	void Reset( int32 InCapacity );
+
+	void Record( const FFactTag Tag, int32 OldValue, int32 NewValue );
+
+	/**
+	 * @param bOutOverflowed true if some records after Sequence are not retained anymore. View contains only retained ones then
+	 * @return records with sequence greater than Sequence. View is valid until next Record
+	 */
+	[[nodiscard]] TConstArrayView< FFactChangeRecord > GetChangesSince( uint64 Sequence, bool& bOutOverflowed ) const;
+
+	// @return sequence of the latest record, 0 if nothing was recorded yet
+	[[nodiscard]] uint64 GetLatestSequence() const { return NextSequence - 1; }
+
+private:
+	TArray< FFactChangeRecord > Records;
+	int32 Capacity = 0;
+
+	uint64 NextSequence = 1;
+	// Sequence of the oldest retained record
+	uint64 FirstSequence = 1;
+};
@@ -0,0 +1,68 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactExpression.h"
+
+struct FFactStorage;
+
+DECLARE_DELEGATE_OneParam( FFactConditionResultChanged, bool )
+
+// Handle to watcher, registered in FFactConditionWatchers. Stale handles are safe to use
+struct SIMPLEFACTS_API FFactWatcherHandle
+{
+	[[nodiscard]] bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { *this = FFactWatcherHandle(); }
+
+private:
+	friend class FFactConditionWatchers;
+
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+};
+
+/**
+ * Keeps results of watched expressions up to date.
+ * Every watcher records facts, that its expression reads, so when some fact changes, only watchers, that depend on it,
+ * are re-evaluated. Delegate of watcher is executed only when result of its expression flips.
+ */
+class SIMPLEFACTS_API FFactConditionWatchers
+{
+public:
+	// Expression must be valid. Initial result is evaluated immediately, delegate is not executed for it
+	FFactWatcherHandle Add( const FFactCompiledExpression& Expression, const FFactStorage& Storage, FFactConditionResultChanged::FDelegate&& Delegate );
+	void Remove( FFactWatcherHandle& Handle );
+
+	// @return last evaluated result of watcher, or false if handle is stale
+	[[nodiscard]] bool GetResult( FFactWatcherHandle Handle ) const;
+
+	// Marks watchers, that depend on fact, for re-evaluation
+	void MarkDirty( int32 FactIndex );
+
+	// Re-evaluates dirty watchers and executes delegates of watchers, whose results have flipped
+	void Update( const FFactStorage& Storage );
+
+	[[nodiscard]] bool IsEmpty() const { return Watchers.Num() == FreeWatchers.Num(); }
+
+private:
+	struct FWatcher
+	{
+		FFactCompiledExpression Expression;
+		FFactConditionResultChanged::FDelegate Delegate;
+		uint32 Generation = 0;
+		bool bResult = false;
+		bool bIsUsed = false;
+		bool bIsDirty = false;
+	};
+
+	[[nodiscard]] const FWatcher* Find( FFactWatcherHandle Handle ) const;
+
+private:
+	TArray< FWatcher > Watchers;
+	TArray< int32 > FreeWatchers;
+	TArray< int32 > DirtyWatchers;
+	
+	// Watchers, that read the fact, indexed by FFactTagIndex (can be shorter than number of facts), so changes don't hash anything
+	TArray< TArray< int32 > > WatchersByFact;
+};
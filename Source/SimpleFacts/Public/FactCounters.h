@@ -0,0 +1,102 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Accumulators for counter facts. Each counter lives in its own cache line, so increments from different threads
+ * don't contend with each other. Accumulated deltas are periodically folded into fact storage on game thread.
+ * Set of counters is fixed after Reset, so Add can be called from any thread.
+ */
+class SIMPLEFACTS_API FFactCounters : public FNoncopyable
+{
+public:
+	// Should be called only from game thread, while no other thread uses counters
+	void Reset( TConstArrayView< int32 > FactIndices );
+
+	[[nodiscard]] bool IsCounter( int32 FactIndex ) const
+	{
+		return SlotOfFact.IsValidIndex( FactIndex ) && SlotOfFact[ FactIndex ] != INDEX_NONE;
+	}
+
+	/**
+	 * Can be called from any thread.
+	 * @return false if fact is not a counter
+	 */
+	bool Add( int32 FactIndex, int32 Delta )
+	{
+		if ( IsCounter( FactIndex ) == false )
+		{
+			return false;
+		}
+
+		Slots[ SlotOfFact[ FactIndex ] ].PendingDelta.fetch_add( Delta, std::memory_order_relaxed );
+		return true;
+	}
+
+	// @return delta, accumulated since last fold, or 0 if fact is not a counter
+	[[nodiscard]] int32 GetPendingDelta( int32 FactIndex ) const
+	{
+		return IsCounter( FactIndex ) ? Slots[ SlotOfFact[ FactIndex ] ].PendingDelta.load( std::memory_order_relaxed ) : 0;
+	}
+
+	// Drops delta, accumulated since last fold (e.g. when counter is explicitly set)
+	void DiscardPendingDelta( int32 FactIndex )
+	{
+		if ( IsCounter( FactIndex ) )
+		{
+			Slots[ SlotOfFact[ FactIndex ] ].PendingDelta.exchange( 0, std::memory_order_relaxed );
+		}
+	}
+
+	// Takes accumulated deltas and calls Func( FactIndex, Delta ) for every counter with non-zero delta
+	template< typename FuncType >
+	void Fold( FuncType&& Func )
+	{
+		for ( int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex )
+		{
+			FSlot& Slot = Slots[ SlotIndex ];
+			if ( Slot.PendingDelta.load( std::memory_order_relaxed ) == 0 )
+			{
+				continue;
+			}
+
+			if ( const int32 Delta = Slot.PendingDelta.exchange( 0, std::memory_order_relaxed ) )
+			{
+				Func( Slot.FactIndex, Delta );
+			}
+		}
+	}
+
+	// Calls Func( FactIndex, Delta ) for every counter with non-zero delta without taking it
+	template< typename FuncType >
+	void ForEachPending( FuncType&& Func ) const
+	{
+		for ( int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex )
+		{
+			const FSlot& Slot = Slots[ SlotIndex ];
+			if ( const int32 Delta = Slot.PendingDelta.load( std::memory_order_relaxed ) )
+			{
+				Func( Slot.FactIndex, Delta );
+			}
+		}
+	}
+
+	[[nodiscard]] bool IsEmpty() const { return NumSlots == 0; }
+
+private:
+	struct alignas( PLATFORM_CACHE_LINE_SIZE ) FSlot
+	{
+		std::atomic< int32 > PendingDelta = 0;
+		int32 FactIndex = INDEX_NONE;
+	};
+
+	TUniquePtr< FSlot[] > Slots;
+	int32 NumSlots = 0;
+
+	// Slot of each fact or INDEX_NONE, indexed by FFactTagIndex
+	TArray< int32 > SlotOfFact;
+};
@@ -0,0 +1,58 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactExpression.h"
+#include "FactTypes.h"
+#include "Engine/DataAsset.h"
+#include "FactDerivedFacts.generated.h"
+
+UENUM(BlueprintType)
+enum class EFactDerivedOperation : uint8
+{
+	// Sum of values of defined sources, clamped to range of int32
+	Sum,
+	// Number of defined sources
+	Count,
+	// Minimum of values of defined sources, 0 if none is defined
+	Min,
+	// Maximum of values of defined sources, 0 if none is defined
+	Max,
+	// 1 if condition passes, otherwise 0
+	Condition
+};
+
+/**
+ * Fact, whose value is computed from other facts (which can be derived too) and is kept up to date by UFactSubsystem.
+ * Derived fact is always defined and can be read like any other fact, but should not be changed directly:
+ * its value is overwritten on next change of its sources.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactDerivedDefinition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	FFactTag Tag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	EFactDerivedOperation Operation = EFactDerivedOperation::Sum;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact", meta = (EditCondition = "Operation != EFactDerivedOperation::Condition", EditConditionHides))
+	TArray< FFactTag > Sources;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact", meta = (EditCondition = "Operation == EFactDerivedOperation::Condition", EditConditionHides))
+	FFactExpression Condition;
+};
+
+// Set of derived facts, that can be registered in UFactSubsystem at runtime (e.g. by game feature)
+UCLASS()
+class SIMPLEFACTS_API UFactDerivedFacts final : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Fact")
+	TArray< FFactDerivedDefinition > Definitions;
+};
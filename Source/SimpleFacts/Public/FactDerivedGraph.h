@@ -0,0 +1,78 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactDerivedFacts.h"
+#include "FactExpression.h"
+
+struct FFactStorage;
+
+/**
+ * Dependency graph of derived facts.
+ * Nodes are kept in topological order, so when some facts change, only derived facts, that depend on them (directly or
+ * through other derived facts), are recomputed, each one once, after all of its sources are up to date.
+ */
+class SIMPLEFACTS_API FFactDerivedGraph
+{
+public:
+	/**
+	 * Adds definitions and rebuilds topological order. Definitions with invalid tags, of already derived facts or forming a cycle
+	 * are skipped with errors. Added facts are marked dirty, so they are computed on next Update.
+	 * Should be called only from game thread (conditions are compiled here).
+	 */
+	void Add( TConstArrayView< FFactDerivedDefinition > Definitions );
+
+	/**
+	 * Should be called for every change of fact. Marks derived facts, that read fact, for recomputation.
+	 * If fact is derived itself and it wasn't written by Update (e.g. it was reset, undefined or replaced by load), it is marked too,
+	 * so its value is restored on next Update.
+	 */
+	void MarkDirty( int32 FactIndex );
+
+	[[nodiscard]] bool HasDirtyNodes() const { return DirtyNodes.Num() > 0; }
+
+	[[nodiscard]] bool IsDerived( int32 FactIndex ) const
+	{
+		return NodeOfFact.IsValidIndex( FactIndex ) && NodeOfFact[ FactIndex ] != INDEX_NONE;
+	}
+
+	/**
+	 * Recomputes dirty derived facts in topological order and calls Write( FactIndex, Value ) for each of them.
+	 * Write should store value and call MarkDirty, if value was changed, so dependent facts are recomputed in the same pass.
+	 */
+	void Update( const FFactStorage& Storage, TFunctionRef< void( int32 FactIndex, int32 Value ) > Write );
+
+private:
+	struct FNode
+	{
+		int32 FactIndex = INDEX_NONE;
+		EFactDerivedOperation Operation = EFactDerivedOperation::Sum;
+		// Unique facts, read by node (facts of condition for Condition operation)
+		TArray< int32 > SourceIndices;
+		FFactCompiledExpression Expression;
+		bool bIsDirty = false;
+	};
+
+	[[nodiscard]] static int32 Evaluate( const FNode& Node, const FFactStorage& Storage );
+
+	void MarkNodeDirty( int32 NodeIndex );
+
+	// Sorts nodes topologically (removing ones, that form cycles or depend on them) and rebuilds lookups
+	void BuildOrder();
+
+	// Logs nodes, that weren't sorted: ones, that form cycles, and ones, that only depend on them
+	void ReportCycles( TConstArrayView< int32 > InDegrees, TConstArrayView< TArray< int32 > > Dependents ) const;
+
+private:
+	// In topological order, so node index is also its rank
+	TArray< FNode > Nodes;
+	// Node of derived fact or INDEX_NONE, indexed by FFactTagIndex
+	TArray< int32 > NodeOfFact;
+	// Nodes, that read the fact, indexed by FFactTagIndex
+	TArray< TArray< int32 > > DependentsOfFact;
+	// Heap of dirty node indices, lowest rank first
+	TArray< int32 > DirtyNodes;
+	// Node, which value is being written by Update
+	int32 UpdatingNode = INDEX_NONE;
+};
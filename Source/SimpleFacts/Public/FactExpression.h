@@ -0,0 +1,157 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+#include "FactExpression.generated.h"
+
+UENUM(BlueprintType)
+enum class EFactExpressionNodeType : uint8
+{
+	Condition,
+	And UMETA(DisplayName = "AND"),
+	Or UMETA(DisplayName = "OR"),
+	Not UMETA(DisplayName = "NOT")
+};
+
+/**
+ * Single node of FFactExpression.
+ * Operands of AND/OR/NOT node are nodes, that directly follow it and have Depth greater by one:
+ *
+ *	AND					(Depth 0)
+ *		Fact.A >= 2		(Depth 1)
+ *		OR				(Depth 1)
+ *			Fact.B == 1	(Depth 2)
+ *			Fact.C defined	(Depth 2)
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactExpressionNode
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	EFactExpressionNodeType Type = EFactExpressionNodeType::Condition;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact", meta = (ClampMin = 0))
+	int32 Depth = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact", meta = (EditCondition = "Type == EFactExpressionNodeType::Condition", EditConditionHides))
+	FFactCondition Condition;
+};
+
+// Flat instruction list over resolved fact indices, produced by compiling FFactExpression
+struct SIMPLEFACTS_API FFactCompiledExpression
+{
+	enum class EOpCode : uint8
+	{
+		Test,			// Result = Compare( Fact, Operator, WantedValue )
+		JumpIfFalse,	// short-circuit of AND
+		JumpIfTrue,		// short-circuit of OR
+		Not				// Result = !Result
+	};
+
+	struct FInstruction
+	{
+		EOpCode OpCode;
+		EFactCompareOperator Operator;
+		int32 Operand;		// fact index for Test, target instruction for jumps
+		int32 WantedValue;
+	};
+
+	TArray< FInstruction > Instructions;
+
+	// Unique indices of all facts, read by expression
+	TArray< int32 > FactIndices;
+
+	bool bIsValid = false;
+
+	/**
+	 * Evaluates expression with short-circuiting.
+	 * StorageType must provide "const int32* Find( int32 Index ) const", returning nullptr for undefined facts.
+	 */
+	template< typename StorageType >
+	[[nodiscard]] bool Evaluate( const StorageType& Storage ) const
+	{
+		bool bResult = false;
+		for ( int32 Index = 0; Index < Instructions.Num(); )
+		{
+			const FInstruction& Instruction = Instructions[ Index ];
+			switch ( Instruction.OpCode ) {
+			case EOpCode::Test:
+				bResult = FFactCondition::Compare( Storage.Find( Instruction.Operand ), Instruction.Operator, Instruction.WantedValue );
+				++Index;
+				break;
+			case EOpCode::JumpIfFalse:
+				Index = bResult ? Index + 1 : Instruction.Operand;
+				break;
+			case EOpCode::JumpIfTrue:
+				Index = bResult ? Instruction.Operand : Index + 1;
+				break;
+			case EOpCode::Not:
+				bResult = !bResult;
+				++Index;
+				break;
+			default:
+				checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+				return false;
+			}
+		}
+
+		return bResult;
+	}
+};
+
+/**
+ * Compound fact condition with nested AND/OR/NOT groups.
+ * Compiled only once (on first evaluation) into flat instruction list, so evaluation doesn't do any tag lookups.
+ * If Nodes are modified from C++, Invalidate must be called.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactExpression
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	TArray< FFactExpressionNode > Nodes;
+
+	/**
+	 * @return compiled expression. If compilation fails, errors are logged and returned expression is not valid
+	 */
+	const FFactCompiledExpression& GetCompiled() const;
+
+	// Drops compiled expression, it will be compiled again on next evaluation
+	void Invalidate() { Compiled.Reset(); }
+
+	FString ToString() const;
+
+	// Serialization (loading, undo/redo) replaces nodes, so compiled expression is dropped
+	void PostSerialize( const FArchive& Ar ) { Invalidate(); }
+
+private:
+	void Compile() const;
+	int32 CompileNode( int32 NodeIndex, FFactCompiledExpression& OutCompiled ) const;
+
+#if WITH_EDITOR
+	uint32 CalculateNodesHash() const;
+#endif
+
+	mutable TSharedPtr< const FFactCompiledExpression > Compiled;
+#if WITH_EDITOR
+	/**
+	 * Nodes can be changed in details panel while game is running. Every such edit broadcasts property change,
+	 * so nodes are rehashed only when some property was edited after expression had been compiled, not on every evaluation.
+	 */
+	mutable uint32 CompiledNodesHash = 0;
+	mutable uint32 CompiledEditSerial = 0;
+#endif
+};
+
+template<>
+struct TStructOpsTypeTraits< FFactExpression > : public TStructOpsTypeTraitsBase2< FFactExpression >
+{
+	enum
+	{
+		WithPostSerialize = true
+	};
+};
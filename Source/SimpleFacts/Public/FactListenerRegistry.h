@@ -0,0 +1,104 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam( FFactChanged, int32 )
+DECLARE_MULTICAST_DELEGATE_TwoParams( FFactSubtreeChanged, FFactTag, int32 )
+
+enum class EFactListenerType : uint8
+{
+	ValueChanged,
+	BecameDefined,
+	BecameUndefined
+};
+
+/**
+ * Handle to listener, registered in FFactListenerRegistry. Handle is generation-checked,
+ * so it is safe to remove listener with stale handle (after its slot was freed and reused by other fact).
+ */
+struct SIMPLEFACTS_API FFactListenerHandle
+{
+	[[nodiscard]] bool IsValid() const { return DelegateHandle.IsValid(); }
+	void Reset() { *this = FFactListenerHandle(); }
+
+private:
+	friend class FFactListenerRegistry;
+
+	int32 SlotIndex = INDEX_NONE;
+	uint32 Generation = 0;
+	FDelegateHandle DelegateHandle;
+};
+
+/**
+ * Storage of fact listeners. Every fact, that has at least one listener, owns one slot with all its delegates.
+ * Slots are allocated in pages (so their addresses are stable while delegates are broadcast) and are freed as soon as
+ * they become empty. Free slots with lowest indices are reused first, and trailing pages without used slots are released,
+ * so memory shrinks back after bursts of listeners.
+ */
+class SIMPLEFACTS_API FFactListenerRegistry
+{
+public:
+	FFactListenerHandle AddListener( int32 FactIndex, EFactListenerType Type, FFactChanged::FDelegate&& Delegate );
+	// Subtree listener is notified about value changes of the fact itself and all its descendants
+	FFactListenerHandle AddSubtreeListener( int32 FactIndex, FFactSubtreeChanged::FDelegate&& Delegate );
+	void RemoveListener( FFactListenerHandle& Handle );
+
+	/**
+	 * Returns delegate of fact, allocating slot for it if needed.
+	 * Slot can't know when such delegate is unbound, so it is freed only after next broadcast, if it was empty at that moment.
+	 */
+	FFactChanged& GetDelegate( int32 FactIndex, EFactListenerType Type );
+
+	void Broadcast( int32 FactIndex, EFactListenerType Type, int32 Value );
+
+	// Notifies subtree listeners of the fact and of all its ancestors. Cost is O(depth of the fact)
+	void BroadcastSubtree( int32 FactIndex, int32 Value );
+
+	[[nodiscard]] int32 NumUsedSlots() const { return NumSlots - FreeSlots.Num(); }
+
+private:
+	struct FSlot
+	{
+		FFactChanged OnValueChanged;
+		FFactChanged OnBecameDefined;
+		FFactChanged OnBecameUndefined;
+		FFactSubtreeChanged OnSubtreeChanged;
+
+		int32 FactIndex = INDEX_NONE;
+		uint32 Generation = 0;
+
+		[[nodiscard]] FFactChanged& GetDelegate( EFactListenerType Type );
+		[[nodiscard]] bool IsEmpty() const;
+	};
+
+	static constexpr int32 SlotsPerPage = 64;
+
+	[[nodiscard]] FSlot& GetSlot( int32 SlotIndex ) const { return Pages[ SlotIndex / SlotsPerPage ][ SlotIndex % SlotsPerPage ]; }
+	[[nodiscard]] int32 FindSlot( int32 FactIndex ) const;
+	int32 FindOrAddSlot( int32 FactIndex );
+
+	// Frees slot if it has no listeners. While some delegate is broadcast, slot is only queued for freeing
+	void FreeSlotIfEmpty( int32 SlotIndex );
+	void FreePendingSlots();
+	void ReleaseEmptyPages();
+
+private:
+	TArray< TUniquePtr< FSlot[] > > Pages;
+	TArray< int32 > NumUsedSlotsInPage;
+	int32 NumSlots = 0;
+	// Min-heap, so slots of trailing pages are reused last and these pages can be released
+	TArray< int32 > FreeSlots;
+	// Generation of slots of new pages, greater than generations of released slots, so stale handles never match them
+	uint32 NextPageGeneration = 0;
+	TArray< int32 > PendingFreeSlots;
+
+	// Slot of every fact (or INDEX_NONE), indexed by FFactTagIndex
+	TArray< int32 > SlotOfFact;
+	int32 BroadcastDepth = 0;
+
+	// Allows to skip walking ancestors, when nobody listens for subtrees
+	int32 NumSubtreeListeners = 0;
+};
@@ -7,6 +7,31 @@
 #include "Engine/DataAsset.h"
 #include "FactPreset.generated.h"
 
+/**
+ * Values of preset, resolved into fact indices (see FFactTagIndex) and sorted by them, so preset can be applied without any tag lookups.
+ * Indices are valid only while first NumTags tags of fact index are the same as they were when image was built.
+ */
+USTRUCT()
+struct SIMPLEFACTS_API FFactPresetImage
+{
+	GENERATED_BODY()
+
+	// @return true if image was built for current fact tag index
+	[[nodiscard]] bool IsUpToDate() const;
+
+	UPROPERTY()
+	TArray< int32 > Indices;
+
+	UPROPERTY()
+	TArray< int32 > Values;
+
+	// Number of tags in fact index and their signature at the moment image was built
+	UPROPERTY()
+	int32 NumTags = INDEX_NONE;
+
+	UPROPERTY()
+	uint32 TagsSignature = 0;
+};
 
 UCLASS()
 class SIMPLEFACTS_API UFactPreset final : public UPrimaryDataAsset
@@ -14,6 +39,25 @@ class SIMPLEFACTS_API UFactPreset final : public UPrimaryDataAsset
 	GENERATED_BODY()
 
 public:
+	virtual void PreSave( FObjectPreSaveContext ObjectSaveContext ) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty( FPropertyChangedEvent& PropertyChangedEvent ) override;
+#endif
+
+	/**
+	 * Image, that is baked at cook time. If preset is not cooked (or fact tags were changed since cooking),
+	 * image is built from PresetValues on first use. Should be called only from game thread.
+	 */
+	[[nodiscard]] const FFactPresetImage& GetImage() const;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Fact", meta = (ForceInlineRow))
 	TMap< FFactTag, int32 > PresetValues;
+
+private:
+	[[nodiscard]] FFactPresetImage BuildImage() const;
+
+	UPROPERTY()
+	FFactPresetImage CookedImage;
+
+	mutable FFactPresetImage TransientImage;
 };
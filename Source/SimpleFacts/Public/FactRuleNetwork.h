@@ -0,0 +1,154 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+#include "UObject/ObjectKey.h"
+
+struct FFactRule;
+struct FFactStorage;
+
+/**
+ * Rete-style match network of fact rules.
+ * Alpha nodes test single condition (fact, operator, value) and are shared by all rules, that use the same condition.
+ * Beta nodes join their parent beta node with one alpha node, so rules, that start with the same conditions, share beta nodes too.
+ * Every node remembers whether it is satisfied, so when fact changes, only alpha nodes of that fact are tested
+ * and only beta nodes, whose inputs have actually flipped, are re-joined.
+ * Rules, whose last beta node becomes satisfied, are queued as activations, which are consumed with PopActivation.
+ */
+class SIMPLEFACTS_API FFactRuleNetwork
+{
+public:
+	struct FAction
+	{
+		int32 FactIndex = INDEX_NONE;
+		EFactValueChangeType ChangeType = EFactValueChangeType::Set;
+		int32 Value = 0;
+	};
+
+	struct FActivation
+	{
+		int32 RuleIndex = INDEX_NONE;
+		// Number of rule firings, that led to this activation
+		int32 Depth = 0;
+		// Firing, that queued this activation, or INDEX_NONE if it wasn't queued by rule
+		int32 Cause = INDEX_NONE;
+	};
+
+	/**
+	 * Compiles rules into network and evaluates new nodes against Storage. Rules, that are already satisfied, are activated.
+	 * Rules with invalid tags or without conditions are skipped with errors.
+	 */
+	void Add( TConstArrayView< FFactRule > Rules, FObjectKey Owner, const FFactStorage& Storage );
+
+	// Removes rules of Owner and rebuilds network from remaining ones. Queued activations are dropped
+	void Remove( FObjectKey Owner, const FFactStorage& Storage );
+
+	[[nodiscard]] bool Contains( FObjectKey Owner ) const;
+
+	/**
+	 * Propagates changed fact through network. Should be called after storage is modified.
+	 * @param bActivate if false, memories of nodes are updated, but satisfied rules are not queued (e.g. when save game is loaded)
+	 */
+	void OnFactChanged( int32 FactIndex, const FFactStorage& Storage, bool bActivate );
+
+	/**
+	 * Should wrap applying actions of fired rule, so activations, queued by them, remember that they were caused by this firing.
+	 * @return false if rule of activation has already fired earlier in the same chain (it is among firings, that caused the activation)
+	 */
+	bool BeginFiring( const FActivation& Activation );
+	void EndFiring();
+
+	// Pops oldest activation, that is still satisfied. @return false if there are no activations
+	bool PopActivation( FActivation& OutActivation );
+
+	[[nodiscard]] bool HasActivations() const { return AgendaHead < Agenda.Num(); }
+
+	[[nodiscard]] TConstArrayView< FAction > GetActions( int32 RuleIndex ) const { return Rules[ RuleIndex ].Actions; }
+	[[nodiscard]] FName GetRuleName( int32 RuleIndex ) const { return Rules[ RuleIndex ].Name; }
+
+private:
+	struct FCondition
+	{
+		int32 FactIndex = INDEX_NONE;
+		EFactCompareOperator Operator = EFactCompareOperator::Equals;
+		int32 WantedValue = 0;
+	};
+
+	struct FRule
+	{
+		FName Name;
+		FObjectKey Owner;
+		TArray< FCondition > Conditions;
+		TArray< FAction > Actions;
+		// Last beta node of rule's join chain
+		int32 BetaNode = INDEX_NONE;
+		// Incremented on every retraction, so activations, that were queued before it, are skipped
+		uint32 ActivationSerial = 0;
+		bool bIsQueued = false;
+	};
+
+	struct FAlphaNode
+	{
+		FCondition Condition;
+		// Beta nodes, that join this node
+		TArray< int32 > BetaNodes;
+		bool bIsSatisfied = false;
+	};
+
+	struct FBetaNode
+	{
+		int32 Parent = INDEX_NONE;
+		int32 AlphaNode = INDEX_NONE;
+		TArray< int32 > Children;
+		TArray< int32 > Rules;
+		bool bIsSatisfied = false;
+	};
+
+	struct FQueuedActivation
+	{
+		int32 RuleIndex = INDEX_NONE;
+		uint32 Serial = 0;
+		int32 Depth = 0;
+		int32 Cause = INDEX_NONE;
+	};
+
+	// Fired rule and firing, that caused it, so every activation can walk its own chain of ancestors
+	struct FFiring
+	{
+		int32 RuleIndex = INDEX_NONE;
+		int32 Cause = INDEX_NONE;
+	};
+
+	// Builds nodes of rule (sharing existing ones) and activates rule if it is satisfied and bActivate is true
+	void Compile( int32 RuleIndex, const FFactStorage& Storage, bool bActivate );
+	[[nodiscard]] int32 FindOrAddAlphaNode( const FCondition& Condition, const FFactStorage& Storage );
+	[[nodiscard]] int32 FindOrAddBetaNode( int32 Parent, int32 AlphaNode );
+
+	// Re-joins beta node and propagates to its children and rules, if result has flipped
+	void UpdateBetaNode( int32 NodeIndex, bool bActivate );
+
+	void Activate( int32 RuleIndex );
+	void Retract( int32 RuleIndex );
+
+private:
+	TArray< FRule > Rules;
+	TArray< FAlphaNode > AlphaNodes;
+	TArray< FBetaNode > BetaNodes;
+
+	// Alpha nodes, that test the fact, indexed by FFactTagIndex
+	TArray< TArray< int32 > > AlphaNodesByFact;
+	// Beta node by its parent and alpha node
+	TMap< TPair< int32, int32 >, int32 > BetaNodesByInputs;
+
+	// Queue of activations in order, in which rules were satisfied
+	TArray< FQueuedActivation > Agenda;
+	int32 AgendaHead = 0;
+
+	// Firings of rules since agenda was empty last time
+	TArray< FFiring > Firings;
+	// Firing, whose actions are being applied, and its depth
+	int32 CurrentFiring = INDEX_NONE;
+	int32 ActivationDepth = 0;
+};
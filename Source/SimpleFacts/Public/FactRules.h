@@ -0,0 +1,56 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+#include "Engine/DataAsset.h"
+#include "FactRules.generated.h"
+
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactRuleAction
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	FFactTag Tag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	EFactValueChangeType ChangeType = EFactValueChangeType::Set;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	int32 Value = 1;
+};
+
+/**
+ * Rule of form "when Fact.A >= 2 and Fact.B is defined, set Fact.C = 1".
+ * Rule fires once, when all its conditions become true, and can fire again only after some of them become false and true again.
+ * Alternatives (OR) are expressed with several rules.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactRule
+{
+	GENERATED_BODY()
+
+	// Used only for logging
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	FName Name;
+
+	// All conditions should pass for rule to fire
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	TArray< FFactCondition > Conditions;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fact")
+	TArray< FFactRuleAction > Actions;
+};
+
+// Set of rules, that are registered in UFactSubsystem together (from plugin settings or at runtime, e.g. by game feature)
+UCLASS()
+class SIMPLEFACTS_API UFactRules final : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Fact")
+	TArray< FFactRule > Rules;
+};
@@ -3,10 +3,49 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FactStorage.h"
 #include "FactTypes.h"
 #include "GameFramework/SaveGame.h"
+#include "UObject/SoftObjectPath.h"
 #include "FactSave.generated.h"
 
+// Facts, changed between two incremental saves. Values are absolute, so deltas can be applied over any older state
+USTRUCT()
+struct SIMPLEFACTS_API FFactSaveDelta
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray< FFactTag > Tags;
+
+	UPROPERTY()
+	TArray< int32 > Values;
+
+	// Facts, that became undefined
+	UPROPERTY()
+	TArray< FFactTag > UndefinedTags;
+};
+
+// Base image of saved facts, can be built on any thread and then moved into UFactSaveGame
+struct FFactSaveImage
+{
+	TMap< FFactTag, int32 > Facts;
+	TArray< uint8 > PackedFacts;
+	int32 PackedFactsUncompressedSize = 0;
+	TArray< FFactTag > UndefinedFacts;
+};
+
+// Facts, decoded from save game. Can be decoded on any thread and then applied on game thread
+struct FFactLoadResult
+{
+	FFactStorage Facts;
+	// Names of facts, that were not registered in FFactTagIndex at the moment of decoding (tags can be resolved and registered only on game thread)
+	TMap< FName, int32 > UnresolvedFacts;
+	// Facts, that were undefined by save (they matter only if baseline defines them)
+	TArray< FFactTag > UndefinedFacts;
+	bool bSuccess = true;
+};
+
 UCLASS(BlueprintType)
 class SIMPLEFACTS_API UFactSaveGame : public USaveGame
 {
@@ -15,6 +54,41 @@ class SIMPLEFACTS_API UFactSaveGame : public USaveGame
 public:
 	UFactSaveGame() {}
 
+	// Base image: all defined facts at the moment of last full save or compaction.
+	// Only one of Facts and PackedFacts is filled, depending on UFactSettings::bCompactSaveFormat (saves made before compact format was introduced have only Facts)
 	UPROPERTY()
 	TMap< FFactTag, int32 > Facts;
+
+	// Base image in compact binary format (see FactSaveFormat)
+	UPROPERTY()
+	TArray< uint8 > PackedFacts;
+
+	// Size of PackedFacts before compression, 0 if they are not compressed
+	UPROPERTY()
+	int32 PackedFactsUncompressedSize = 0;
+
+	// Facts of baseline, that were undefined at the moment of saving base image
+	UPROPERTY()
+	TArray< FFactTag > UndefinedFacts;
+
+	// Baseline preset (see UFactSubsystem::SetFactBaseline), saved facts are overrides on top of it. Empty if all facts are saved
+	UPROPERTY()
+	FSoftObjectPath Baseline;
+
+	// Incremental saves, written after base image, in order of saving. Merged into base image by compaction
+	UPROPERTY()
+	TArray< FFactSaveDelta > Deltas;
+
+	void SetBaseImage( FFactSaveImage&& Image )
+	{
+		Facts = MoveTemp( Image.Facts );
+		PackedFacts = MoveTemp( Image.PackedFacts );
+		PackedFactsUncompressedSize = Image.PackedFactsUncompressedSize;
+		UndefinedFacts = MoveTemp( Image.UndefinedFacts );
+	}
+
+	[[nodiscard]] FFactSaveImage GetBaseImage() const
+	{
+		return { Facts, PackedFacts, PackedFactsUncompressedSize, UndefinedFacts };
+	}
 };
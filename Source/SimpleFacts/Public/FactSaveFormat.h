@@ -0,0 +1,51 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactSave.h"
+#include "FactTypes.h"
+
+class FFactTagIndex;
+
+/**
+ * Compact binary format of saved facts:
+ * version byte, varint count of tags and table of their names (varint length + UTF-8),
+ * varint count of entries and entries themselves (varint index into table of names, zig-zag varint value).
+ * Indices in FFactTagIndex differ between builds, so saved facts reference only their local table of names.
+ */
+namespace FactSaveFormat
+{
+	class SIMPLEFACTS_API FWriter
+	{
+	public:
+		// Each tag should be added only once
+		void Add( const FFactTag Tag, int32 Value );
+
+		// Writes header and all added facts into OutBytes
+		void Finish( TArray< uint8 >& OutBytes ) const;
+
+	private:
+		TArray< uint8 > Names;
+		TArray< uint8 > Entries;
+		int32 NumTags = 0;
+	};
+
+	/**
+	 * Resolves saved tag names into current fact indices once, then calls Func( TagName, Index, Value ) for every saved fact in single pass.
+	 * Index is INDEX_NONE if name is not registered in TagIndex (tag can be valid, but not registered yet, or not valid anymore),
+	 * such names should be resolved on game thread. Can be called from any thread.
+	 * @return false if data is corrupted (facts before corrupted entry are still reported)
+	 */
+	SIMPLEFACTS_API bool Read( TConstArrayView< uint8 > Bytes, const FFactTagIndex& TagIndex, TFunctionRef< void( const FName TagName, int32 Index, int32 Value ) > Func );
+
+	// Compresses packed facts of image in place
+	SIMPLEFACTS_API void Compress( FFactSaveImage& Image );
+
+	/**
+	 * Decodes base image (in any format) and applies deltas on top of it. Can be called from any thread,
+	 * TagIndex should be acquired on game thread.
+	 * @param NumFacts number of facts, that storage of result should be preallocated for
+	 */
+	SIMPLEFACTS_API FFactLoadResult Decode( const FFactSaveImage& Image, TConstArrayView< FFactSaveDelta > Deltas, const FFactTagIndex& TagIndex, int32 NumFacts );
+}
@@ -0,0 +1,68 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactDerivedFacts.h"
+#include "FactTypes.h"
+#include "Engine/DeveloperSettings.h"
+#include "FactSettings.generated.h"
+
+class UFactRules;
+
+UCLASS( Config = Game, DefaultConfig, meta = ( DisplayName = "Simple Facts" ) )
+class SIMPLEFACTS_API UFactSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UFactSettings();
+
+	/**
+	 * Facts, that are pure counters and are incremented very often, possibly from several threads (shots fired, steps taken etc).
+	 * Adds to them are accumulated in atomic slots and are folded into fact value (with notification) once per CounterFoldInterval.
+	 */
+	UPROPERTY( Config, EditAnywhere, Category = "Counters" )
+	TArray< FFactTag > CounterFacts;
+
+	// How often (in seconds) accumulated counter increments are applied to facts. 0 means every frame
+	UPROPERTY( Config, EditAnywhere, Category = "Counters", meta = ( ClampMin = 0, Units = "s" ) )
+	float CounterFoldInterval = 0.f;
+
+	// How many latest fact changes are kept for UFactSubsystem::GetChangesSince. 0 disables change journal
+	UPROPERTY( Config, EditAnywhere, Category = "Journal", meta = ( ClampMin = 0 ) )
+	int32 ChangeJournalCapacity = 1024;
+
+	/**
+	 * If enabled, facts are saved in compact binary format (table of tag names and varint-encoded values) instead of map of tags.
+	 * Saves in both formats can be loaded regardless of this setting.
+	 */
+	UPROPERTY( Config, EditAnywhere, Category = "Save" )
+	bool bCompactSaveFormat = true;
+
+	/**
+	 * If enabled, UFactSubsystem::OnGameSaved writes only facts, changed since previous save, as delta record,
+	 * when the same save game object is saved again (or was loaded last). Otherwise all facts are written every time.
+	 */
+	UPROPERTY( Config, EditAnywhere, Category = "Save" )
+	bool bIncrementalSaves = false;
+
+	// When save game accumulates this many delta records, they are merged into its base image on background thread
+	UPROPERTY( Config, EditAnywhere, Category = "Save", meta = ( ClampMin = 1, EditCondition = "bIncrementalSaves" ) )
+	int32 MaxSaveDeltas = 16;
+
+	// Facts, computed from other facts, that are registered in UFactSubsystem on its initialization
+	UPROPERTY( Config, EditAnywhere, Category = "Derived Facts" )
+	TArray< FFactDerivedDefinition > DerivedFacts;
+
+	// Rule sets, that are loaded and registered in UFactSubsystem on its initialization
+	UPROPERTY( Config, EditAnywhere, Category = "Rules" )
+	TArray< TSoftObjectPtr< UFactRules > > Rules;
+
+	/**
+	 * Maximum length of chain of rule firings, where each rule is activated by actions of previous one.
+	 * Activations beyond it are dropped with warning. Rule also isn't fired, if it is activated by a chain, which it has already fired in, so cycles always terminate.
+	 */
+	UPROPERTY( Config, EditAnywhere, Category = "Rules", meta = ( ClampMin = 1 ) )
+	int32 MaxRuleChainDepth = 16;
+};
@@ -0,0 +1,211 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactStorage.h"
+#include "FactTypes.h"
+
+#include <atomic>
+
+struct FFactCompiledExpression;
+
+// Immutable copy of one FFactStorage chunk. Unchanged chunks are shared between consecutive snapshots
+struct FFactSnapshotChunk
+{
+	int32 Values[ FFactStorage::ChunkSize ];
+	uint32 DefinedWords[ FFactStorage::ChunkSize / NumBitsPerDWORD ];
+
+	// @return pointer to value of defined fact with index local to this chunk or nullptr if fact is undefined
+	[[nodiscard]] const int32* Find( int32 LocalIndex ) const
+	{
+		const bool bIsDefined = ( DefinedWords[ LocalIndex / NumBitsPerDWORD ] & ( 1u << ( LocalIndex % NumBitsPerDWORD ) ) ) != 0;
+		return bIsDefined ? &Values[ LocalIndex ] : nullptr;
+	}
+};
+
+using FFactSnapshotChunkPtr = TSharedPtr< const FFactSnapshotChunk, ESPMode::ThreadSafe >;
+
+// Fixed-size group of chunk pointers. Pages without modified chunks are shared between snapshots, so publication doesn't copy whole chunk table
+struct FFactSnapshotChunkPage
+{
+	static constexpr int32 NumChunks = 64;
+	static constexpr int32 ChunkShift = 6;
+
+	FFactSnapshotChunkPtr Chunks[ NumChunks ];
+};
+
+/**
+ * Immutable, versioned view of all fact values at the moment of publication.
+ * Snapshot is never modified after it is published, so it can be read from any thread without locks.
+ * Read functions mirror UFactSubsystem ones.
+ */
+class SIMPLEFACTS_API FFactSnapshot
+{
+public:
+	// Version grows with each published snapshot, so readers can cheaply detect, that they hold outdated snapshot
+	[[nodiscard]] uint64 GetVersion() const { return Version; }
+
+	/**
+	 * @return pointer to value of defined fact or nullptr if fact is undefined
+	 */
+	[[nodiscard]] const int32* Find( int32 Index ) const
+	{
+		const FFactSnapshotChunk* Chunk = Index >= 0 ? GetChunk( Index >> FFactStorage::ChunkShift ) : nullptr;
+		return Chunk != nullptr ? Chunk->Find( Index & ( FFactStorage::ChunkSize - 1 ) ) : nullptr;
+	}
+
+	/**
+	 * If Fact is not defined, then OutValue is also undefined and should not be used!
+	 * @return false if fact is undefined
+	 */
+	[[nodiscard]] bool GetFactValueIfDefined( const FFactTag Tag, int32& OutValue ) const;
+	[[nodiscard]] bool GetFactValueIfDefined( const FFactHandle Handle, int32& OutValue ) const;
+
+	[[nodiscard]] bool IsFactDefined( const FFactTag Tag ) const;
+	[[nodiscard]] bool IsFactDefined( const FFactHandle Handle ) const;
+
+	/**
+	 * Same as UFactSubsystem::CheckFactCondition. Doesn't use cached handle of condition (it is not thread safe),
+	 * so on hot paths prefer overload with handle, resolved on game thread.
+	 */
+	[[nodiscard]] bool CheckFactCondition( const FFactCondition& Condition ) const;
+	[[nodiscard]] bool CheckFactCondition( const FFactHandle Handle, EFactCompareOperator Operator, int32 WantedValue ) const;
+
+	// Expression must be compiled on game thread (FFactExpression::GetCompiled)
+	[[nodiscard]] bool CheckFactExpression( const FFactCompiledExpression& Expression ) const;
+
+	// Calls Func( Index, Value ) for every defined fact in ascending index order
+	template< typename FuncType >
+	void ForEachDefined( FuncType&& Func ) const
+	{
+		for ( int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex )
+		{
+			const FFactSnapshotChunk& Chunk = *GetChunk( ChunkIndex );
+			for ( int32 WordIndex = 0; WordIndex < UE_ARRAY_COUNT( Chunk.DefinedWords ); ++WordIndex )
+			{
+				for ( uint32 Word = Chunk.DefinedWords[ WordIndex ]; Word != 0; Word &= Word - 1 )
+				{
+					const int32 LocalIndex = WordIndex * NumBitsPerDWORD + FMath::CountTrailingZeros( Word );
+					Func( ( ChunkIndex << FFactStorage::ChunkShift ) + LocalIndex, Chunk.Values[ LocalIndex ] );
+				}
+			}
+		}
+	}
+
+	/**
+	 * Calls Func( Index, FromValue, ToValue ) for every fact, that has different state in two snapshots (value is nullptr if fact is undefined).
+	 * Chunks (and whole pages of chunks), shared by both snapshots, are skipped without reading them, so cost depends on number of changed chunks.
+	 */
+	template< typename FuncType >
+	static void ForEachDifference( const FFactSnapshot& From, const FFactSnapshot& To, FuncType&& Func )
+	{
+		const int32 MaxNumChunks = FMath::Max( From.NumChunks, To.NumChunks );
+		for ( int32 ChunkIndex = 0; ChunkIndex < MaxNumChunks; ++ChunkIndex )
+		{
+			const int32 PageIndex = ChunkIndex >> FFactSnapshotChunkPage::ChunkShift;
+			const bool bIsPageShared = From.NumChunks == To.NumChunks && From.Pages[ PageIndex ] == To.Pages[ PageIndex ];
+			if ( bIsPageShared )
+			{
+				ChunkIndex = ( ( PageIndex + 1 ) << FFactSnapshotChunkPage::ChunkShift ) - 1;
+				continue;
+			}
+
+			const FFactSnapshotChunk* FromChunk = From.GetChunk( ChunkIndex );
+			const FFactSnapshotChunk* ToChunk = To.GetChunk( ChunkIndex );
+			if ( FromChunk == ToChunk )
+			{
+				continue;
+			}
+
+			for ( int32 LocalIndex = 0; LocalIndex < FFactStorage::ChunkSize; ++LocalIndex )
+			{
+				const int32* FromValue = FromChunk != nullptr ? FromChunk->Find( LocalIndex ) : nullptr;
+				const int32* ToValue = ToChunk != nullptr ? ToChunk->Find( LocalIndex ) : nullptr;
+				const bool bIsSame = FromValue == nullptr ? ToValue == nullptr : ToValue != nullptr && *FromValue == *ToValue;
+				if ( bIsSame == false )
+				{
+					Func( ( ChunkIndex << FFactStorage::ChunkShift ) + LocalIndex, FromValue, ToValue );
+				}
+			}
+		}
+	}
+
+private:
+	friend class FFactSnapshotPublisher;
+
+	// @return chunk or nullptr if it is out of snapshot bounds
+	[[nodiscard]] const FFactSnapshotChunk* GetChunk( int32 ChunkIndex ) const
+	{
+		if ( ChunkIndex >= NumChunks )
+		{
+			return nullptr;
+		}
+
+		return Pages[ ChunkIndex >> FFactSnapshotChunkPage::ChunkShift ]->Chunks[ ChunkIndex & ( FFactSnapshotChunkPage::NumChunks - 1 ) ].Get();
+	}
+
+	TArray< TSharedPtr< const FFactSnapshotChunkPage, ESPMode::ThreadSafe > > Pages;
+	int32 NumChunks = 0;
+	uint64 Version = 0;
+};
+
+using FFactSnapshotPtr = TSharedPtr< const FFactSnapshot, ESPMode::ThreadSafe >;
+
+/**
+ * State of all facts, taken by UFactSubsystem::TakeFactCheckpoint and restored by UFactSubsystem::RestoreFactCheckpoint.
+ * Checkpoint is just a snapshot, which shares unchanged chunks with live facts and other checkpoints, so it is cheap to take, copy and keep.
+ */
+struct FFactCheckpoint
+{
+	[[nodiscard]] bool IsValid() const { return Snapshot.IsValid(); }
+
+	// Facts at the moment checkpoint was taken, can be read from any thread (e.g. to preview some choice)
+	[[nodiscard]] const FFactSnapshotPtr& GetSnapshot() const { return Snapshot; }
+
+private:
+	friend class UFactSubsystem;
+	
+	FFactSnapshotPtr Snapshot;
+};
+
+/**
+ * Publishes snapshots of FFactStorage (read-copy-update).
+ * Game thread publishes new snapshot by copying only chunks, that were modified since previous publication (and pages of pointers to them),
+ * other chunks and pages are shared with previous snapshot. Any thread can acquire latest snapshot without locks.
+ */
+class SIMPLEFACTS_API FFactSnapshotPublisher : public FNoncopyable
+{
+public:
+	/**
+	 * Builds new snapshot from modified chunks of storage and makes it current. Should be called only from game thread.
+	 * If storage has no modifications, current snapshot stays as is.
+	 */
+	void Publish( FFactStorage& Storage );
+
+	/**
+	 * Can be called from any thread. Returned snapshot stays valid for as long as caller holds it.
+	 * @return latest published snapshot, null if nothing was published yet
+	 */
+	[[nodiscard]] FFactSnapshotPtr Acquire() const;
+
+	// @return latest built snapshot, which can be newer than acquired one. Should be called only from game thread
+	[[nodiscard]] const FFactSnapshotPtr& GetLatest() const
+	{
+		check( IsInGameThread() );
+		return Latest;
+	}
+
+private:
+	// Snapshot is written only into slot, that is not current and is not being read, so readers never see partially written pointer
+	static constexpr int32 NumSlots = 3;
+
+	FFactSnapshotPtr Slots[ NumSlots ];
+	mutable std::atomic< int32 > SlotReaders[ NumSlots ] = {};
+	std::atomic< int32 > CurrentSlot = 0;
+
+	// Latest built snapshot, accessed only from game thread. Can be newer than current one, if all free slots were busy
+	FFactSnapshotPtr Latest;
+	bool bLatestPublished = true;
+	uint64 LastVersion = 0;
+};
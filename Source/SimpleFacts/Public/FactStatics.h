@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FactAggregates.h"
+#include "FactExpression.h"
 #include "FactTypes.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "FactStatics.generated.h"
@@ -23,6 +25,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
 	static void ChangeFactValue( const UObject* WorldContextObject, const FFactTag Tag, int32 NewValue, EFactValueChangeType ChangeType );
 
+	/**
+	 * Applies all changes first and only after that notifies listeners: once per changed fact with its final value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	static void ChangeFactValues( const UObject* WorldContextObject, const TArray< FFactChange >& Changes );
+
+	/**
+	 * Opens fact change scope: until matching EndFactChangeScope, listeners are not notified about changed facts.
+	 * After the outermost scope is closed, every changed fact is notified once with its final value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	static void BeginFactChangeScope( const UObject* WorldContextObject );
+
+	/**
+	 * Closes scope, opened with BeginFactChangeScope. Must be called exactly once for each BeginFactChangeScope.
+	 */
+	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	static void EndFactChangeScope( const UObject* WorldContextObject );
+
 	/**
 	 * Only defined facts can be reset now. Can change it in the future, if there will be some use cases for resetting undefined facts.
 	 */
@@ -56,6 +77,13 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Facts, meta = (WorldContext = "WorldContextObject"))
 	[[nodiscard]] static bool CheckFactCondition( const UObject* WorldContextObject, FFactCondition Condition );
 	
+	/**
+	 * Checks compound condition with nested AND/OR/NOT groups. Expression is compiled once and evaluated natively.
+	 * @return false if WorldContextObject is null or expression is not valid
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	[[nodiscard]] static bool CheckFactExpression( const UObject* WorldContextObject, const FFactExpression& Expression );
+	
 	/**
 	 * @return false if WorldContextObject is null
 	 * More specialized version of CheckFactValue, which only tell if fact is defined or not
@@ -63,6 +91,29 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Facts, meta = (WorldContext = "WorldContextObject"))
 	[[nodiscard]] static bool IsFactDefined( const UObject* WorldContextObject, const FFactTag Tag );
 
+	/**
+	 * Collects all defined facts under ParentTag (including ParentTag itself) without iterating all facts.
+	 * OutFacts is empty if WorldContextObject is null
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	static void GetFactsUnderTag( const UObject* WorldContextObject, const FFactTag ParentTag, TMap< FFactTag, int32 >& OutFacts );
+
+	/**
+	 * Number, sum, min and max of values of all defined facts under ParentTag (including ParentTag itself), e.g. sum of Fact.Stats.Kills.
+	 * Aggregates are maintained incrementally, so reading them doesn't scan facts.
+	 * @return empty aggregate if WorldContextObject is null
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	[[nodiscard]] static FFactAggregate GetFactAggregate( const UObject* WorldContextObject, const FFactTag ParentTag );
+
+	// Resets values of all defined facts under ParentTag (including ParentTag itself) to default (0)
+	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	static void ResetFactsUnderTag( const UObject* WorldContextObject, const FFactTag ParentTag );
+
+	// Makes all facts under ParentTag (including ParentTag itself) undefined
+	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
+	static void UndefineFactsUnderTag( const UObject* WorldContextObject, const FFactTag ParentTag );
+
 	UFUNCTION(BlueprintCallable, Category = Facts, meta = (WorldContext = "WorldContextObject"))
 	static void LoadFactPreset( const UObject* WorldContextObject, const UFactPreset* Preset );
 
@@ -0,0 +1,111 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Flat storage of fact values, addressed by indices from FFactTagIndex.
+ * Values of all facts live in contiguous array, "defined" state lives in bitset next to it.
+ * Value of undefined fact is always 0, so modifications of undefined fact are applied to default value.
+ * Storage is split into fixed-size chunks, and remembers which of them were modified, so snapshots can be updated incrementally.
+ */
+struct SIMPLEFACTS_API FFactStorage
+{
+	// Number of facts in one chunk. Multiple of 32, so every chunk owns whole words of DefinedBits
+	static constexpr int32 ChunkSize = 256;
+	static constexpr int32 ChunkShift = 8;
+	
+	// Removes all facts and preallocates space for NumFacts facts
+	void Reset( int32 NumFacts );
+
+	[[nodiscard]] bool IsDefined( int32 Index ) const
+	{
+		return DefinedBits.IsValidIndex( Index ) && DefinedBits[ Index ];
+	}
+
+	/**
+	 * @return pointer to value of defined fact or nullptr if fact is undefined
+	 */
+	[[nodiscard]] const int32* Find( int32 Index ) const
+	{
+		return IsDefined( Index ) ? &Values[ Index ] : nullptr;
+	}
+
+	/**
+	 * Sets value of fact and marks it as defined (if it is not already).
+	 * Storage grows if Index is out of its bounds.
+	 */
+	void Set( int32 Index, int32 Value );
+
+	// Marks fact as undefined and resets its value to default
+	void Undefine( int32 Index );
+
+	[[nodiscard]] int32 NumDefined() const { return DefinedCount; }
+
+	// Raw values of all facts (undefined facts have value 0), can be shorter than number of registered facts
+	[[nodiscard]] TConstArrayView< int32 > GetValues() const { return Values; }
+
+	[[nodiscard]] int32 NumChunks() const { return ( Values.Num() + ChunkSize - 1 ) >> ChunkShift; }
+
+	/**
+	 * Copies values and defined bits of one chunk. Facts, that are out of storage bounds, are copied as undefined.
+	 * @param OutDefinedWords must have space for ChunkSize / 32 words
+	 */
+	void CopyChunk( int32 ChunkIndex, int32* OutValues, uint32* OutDefinedWords ) const;
+
+	// @return true if values and defined bits of chunk are the same in both storages (facts out of bounds are treated as undefined)
+	[[nodiscard]] bool IsChunkEqual( int32 ChunkIndex, const FFactStorage& Other ) const;
+
+	/**
+	 * Calls Func( ChunkIndex ) for every chunk, modified since last call, and forgets about modifications.
+	 * Chunks, that were added by growing storage, are reported too. Cost depends only on number of modified chunks.
+	 */
+	template< typename FuncType >
+	void ConsumeDirtyChunks( FuncType&& Func )
+	{
+		for ( const int32 ChunkIndex : DirtyChunkList )
+		{
+			DirtyChunks[ ChunkIndex ] = false;
+			Func( ChunkIndex );
+		}
+		DirtyChunkList.Reset();
+	}
+
+	[[nodiscard]] bool HasDirtyChunks() const { return DirtyChunkList.Num() > 0; }
+
+	// Marks chunk as modified, e.g. when its contents are replaced as a whole
+	void MarkChunkDirtyAt( int32 ChunkIndex );
+
+	// Forgets about all modifications without reporting them (e.g. when they are tracked by the caller instead)
+	void ClearDirtyChunks()
+	{
+		ConsumeDirtyChunks( []( int32 ) {} );
+	}
+
+	// Calls Func( Index, Value ) for every defined fact in ascending index order
+	template< typename FuncType >
+	void ForEachDefined( FuncType&& Func ) const
+	{
+		for ( TConstSetBitIterator<> It( DefinedBits ); It; ++It )
+		{
+			const int32 Index = It.GetIndex();
+			Func( Index, Values[ Index ] );
+		}
+	}
+
+private:
+	void MarkChunkDirty( int32 Index )
+	{
+		MarkChunkDirtyAt( Index >> ChunkShift );
+	}
+
+private:
+	TArray< int32 > Values;
+	TBitArray<> DefinedBits;
+	int32 DefinedCount = 0;
+
+	// Modified chunks as bitset (to add each one once) and as list (to visit only them)
+	TBitArray<> DirtyChunks;
+	TArray< int32 > DirtyChunkList;
+};
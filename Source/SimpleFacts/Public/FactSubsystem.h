@@ -3,13 +3,34 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "FactAggregates.h"
+#include "FactChangeJournal.h"
+#include "FactConditionWatchers.h"
+#include "FactCounters.h"
+#include "FactDerivedGraph.h"
+#include "FactExpression.h"
+#include "FactListenerRegistry.h"
+#include "FactRuleNetwork.h"
+#include "FactSave.h"
+#include "FactSnapshot.h"
+#include "FactStorage.h"
+#include "FactThresholds.h"
 #include "FactTypes.h"
 #include "FactSubsystem.generated.h"
 
-class UFactSaveGame;
-DECLARE_MULTICAST_DELEGATE_OneParam( FFactChanged, int32 )
-DECLARE_MULTICAST_DELEGATE( FFactLoaded )
+struct FFactPresetImage;
+class UFactPreset;
+class UFactDerivedFacts;
+class UFactRules;
+
+DECLARE_MULTICAST_DELEGATE_OneParam( FFactLoaded, TConstArrayView< FFactTag > /*ChangedTags*/ )
+DECLARE_MULTICAST_DELEGATE( FFactsBatchChanged )
+DECLARE_DELEGATE_OneParam( FFactSaveCompleted, bool /*bSuccess*/ )
+DECLARE_DELEGATE_OneParam( FFactLoadCompleted, bool /*bSuccess*/ )
 
 /**
  * 
@@ -25,20 +46,72 @@ public:
 	 */
 	[[nodiscard]] static UFactSubsystem& Get( const UObject* WorldContextObject );
 
+	virtual void Initialize( FSubsystemCollectionBase& Collection ) override;
+	virtual void Deinitialize() override;
+	virtual void Serialize( FArchive& Ar ) override;
+
+	// Overloads, that accept FFactHandle, are intended for native hot paths: they skip tag validation and lookup,
+	// so handle must be valid (see FFactHandle::Resolve)
+
 	// Changes fact value depending on EFactValueChangeType.
 	// If fact is undefined, then modification is applied to default type's value (for int32 it is 0)
+	// Adds to counter facts (see UFactSettings::CounterFacts) are only accumulated and are applied on next FoldFactCounters
 	void ChangeFactValue( const FFactTag Tag, int32 NewValue, EFactValueChangeType ChangeType );
+	void ChangeFactValue( const FFactHandle Handle, int32 NewValue, EFactValueChangeType ChangeType );
+
+	/**
+	 * Applies all changes first and only after that notifies listeners: once per changed fact with its final value.
+	 * OnFactsBatchChanged is broadcast after all notifications, if at least one fact was changed.
+	 */
+	void ChangeFactValues( TArrayView< const FFactChange > Changes );
+
+	/**
+	 * Sets values of all facts from preset image (see UFactPreset::GetImage) in single pass without any tag lookups.
+	 * Same as ChangeFactValues, listeners are notified once per changed fact after all values are set.
+	 */
+	void LoadFactPreset( const FFactPresetImage& Image );
+
+	/**
+	 * Thread-safe version of ChangeFactValue for async jobs: change is pushed into lock-free queue and applied on game thread once per frame.
+	 * Queued changes of the same fact are merged, so listeners are notified once per fact with final value (same as in ChangeFactValues).
+	 */
+	void EnqueueFactChange( const FFactTag Tag, int32 NewValue, EFactValueChangeType ChangeType );
+	void EnqueueFactChange( const FFactHandle Handle, int32 NewValue, EFactValueChangeType ChangeType );
+
+	// Applies all queued changes right away, without waiting for next frame. Should be called only from game thread
+	void FlushQueuedFactChanges();
+
+	/**
+	 * Adds Delta to counter fact from any thread with single atomic operation, without any notifications.
+	 * Accumulated value is applied to fact (and listeners are notified) at cadence, set by UFactSettings::CounterFoldInterval.
+	 * @return false if fact is not a counter
+	 */
+	bool AddToFactCounter( const FFactHandle Handle, int32 Delta );
+
+	// Applies increments, accumulated by counter facts, right away. Should be called only from game thread
+	void FoldFactCounters();
+
+	/**
+	 * While change scope is open, notifications about changed facts are deferred and de-duplicated per fact.
+	 * They are dispatched (with final values) when the outermost scope is closed.
+	 * Each Begin must be paired with End. In C++ prefer FFactChangeScope.
+	 */
+	void BeginFactChangeScope();
+	void EndFactChangeScope();
+	[[nodiscard]] bool IsInFactChangeScope() const { return DeferNotificationsCounter > 0; }
 
 	/**
 	 * Only defined facts can be reset now. Can change it in the future, if there will be some use cases for resetting undefined facts.
 	 */
 	void ResetFactValue( const FFactTag Tag );
+	void ResetFactValue( const FFactHandle Handle );
 
 	/**
 	 * If Fact is not defined, then OutValue is also undefined and should not be used!
 	 * @return false if fact is undefined
 	 */
 	[[nodiscard]] bool GetFactValueIfDefined( const FFactTag Tag, int32& OutValue ) const;
+	[[nodiscard]] bool GetFactValueIfDefined( const FFactHandle Handle, int32& OutValue ) const;
 	/**
 	 * If Fact is not defined, then OutValue is also undefined and should not be used! It is necessary to check if return value is true or false
 	 * @return false if fact is undefined
@@ -50,39 +123,410 @@ public:
 	 * If condition explicitly checks for value, returns false if value is different or fact is undefined.
 	 */ 
 	[[nodiscard]] bool CheckFactCondition( const FFactCondition& Condition ) const;
+	[[nodiscard]] bool CheckFactCondition( const FFactHandle Handle, EFactCompareOperator Operator, int32 WantedValue ) const;
+
+	/**
+	 * Evaluates many conditions at once (e.g. when rebuilding quest availability after load) and writes
+	 * result of Conditions[ I ] into OutResults[ I ]. Conditions are evaluated in groups with SIMD compares,
+	 * which is much faster than calling CheckFactCondition for each of them.
+	 */
+	void CheckFactConditions( TArrayView< const FFactCondition > Conditions, TBitArray<>& OutResults ) const;
+
+	/**
+	 * Returns true if compound Expression passes. Expression is compiled on first use, after that it is evaluated
+	 * without any tag lookups, with short-circuiting.
+	 * Returns false if expression is not valid.
+	 */
+	[[nodiscard]] bool CheckFactExpression( const FFactExpression& Expression ) const;
 
 	/**
 	 * More specialized version of CheckFactCondition, which only tell if fact is defined or not.
 	 */ 
 	[[nodiscard]] bool IsFactDefined( const FFactTag Tag ) const;
+	[[nodiscard]] bool IsFactDefined( const FFactHandle Handle ) const;
+
+	/**
+	 * Collects all defined facts under ParentTag (including ParentTag itself), e.g. Fact.Quest.Side.Started, Fact.Quest.Side.Finished for Fact.Quest.Side.
+	 * Cost depends on size of subtree, not on number of all facts.
+	 */
+	void GetFactsUnderTag( const FFactTag ParentTag, TMap< FFactTag, int32 >& OutFacts ) const;
+
+	/**
+	 * Aggregate over all defined facts under ParentTag (including ParentTag itself): their number, sum, min and max of values
+	 * (e.g. how many Fact.Collectibles are found). Aggregates are maintained on every change, so reading doesn't scan facts.
+	 */
+	[[nodiscard]] FFactAggregate GetFactAggregate( const FFactTag ParentTag ) const;
+	[[nodiscard]] FFactAggregate GetFactAggregate( const FFactHandle ParentHandle ) const;
+
+	// Resets values of all defined facts under ParentTag (including ParentTag itself) to default (0). Listeners are notified once per fact
+	void ResetFactsUnderTag( const FFactTag ParentTag );
+
+	// Makes all facts under ParentTag (including ParentTag itself) undefined. Listeners are notified once per fact
+	void UndefineFactsUnderTag( const FFactTag ParentTag );
 	
-	FFactChanged& GetOnFactValueChangedDelegate( FFactTag Tag );
-	FFactChanged& GetOnFactBecameDefinedDelegate( FFactTag Tag );
+	/**
+	 * Registers listener, which is called every time value of the fact is changed.
+	 * If fact was undefined before changing value, definition listeners are called first.
+	 * @return handle, that should be used for removing listener
+	 */
+	FFactListenerHandle AddFactValueListener( const FFactTag Tag, FFactChanged::FDelegate Delegate );
+	FFactListenerHandle AddFactValueListener( const FFactHandle Handle, FFactChanged::FDelegate Delegate );
+
+	/**
+	 * Registers listener, which is called when fact state changes from undefined to defined.
+	 * @return handle, that should be used for removing listener
+	 */
+	FFactListenerHandle AddFactDefinitionListener( const FFactTag Tag, FFactChanged::FDelegate Delegate );
+	FFactListenerHandle AddFactDefinitionListener( const FFactHandle Handle, FFactChanged::FDelegate Delegate );
+
+	/**
+	 * Registers listener, which is called when fact state changes from defined to undefined (e.g. after loading save game).
+	 * Value listeners are not called in this case, value, passed to listener, is always 0.
+	 * @return handle, that should be used for removing listener
+	 */
+	FFactListenerHandle AddFactUndefinitionListener( const FFactTag Tag, FFactChanged::FDelegate Delegate );
+	FFactListenerHandle AddFactUndefinitionListener( const FFactHandle Handle, FFactChanged::FDelegate Delegate );
+
+	/**
+	 * Registers listener, which is called every time value of the fact or any of its descendants is changed
+	 * (e.g. listener for Fact.Quest is called for Fact.Quest, Fact.Quest.Started, Fact.Quest.Chapter.Finished etc).
+	 * Dispatch cost depends only on depth of changed fact, not on number of subtree listeners.
+	 * @return handle, that should be used for removing listener
+	 */
+	FFactListenerHandle AddFactSubtreeListener( const FFactTag ParentTag, FFactSubtreeChanged::FDelegate Delegate );
+	FFactListenerHandle AddFactSubtreeListener( const FFactHandle ParentHandle, FFactSubtreeChanged::FDelegate Delegate );
+
+	// Removes listener and resets handle. Stale handles are ignored
+	void RemoveFactListener( FFactListenerHandle& Handle );
+
+	/**
+	 * Registers watcher, which is notified only when result of expression flips (instead of polling it every frame).
+	 * Watcher depends only on facts, that expression reads, so it is re-evaluated only when one of them changes.
+	 * Initial result is evaluated immediately and can be read with GetFactConditionWatcherResult, delegate is not executed for it.
+	 * @return handle, that should be used for removing watcher. Invalid if expression is not valid
+	 */
+	FFactWatcherHandle AddFactConditionWatcher( const FFactExpression& Expression, FFactConditionResultChanged::FDelegate Delegate );
+	FFactWatcherHandle AddFactConditionWatcher( const FFactCondition& Condition, FFactConditionResultChanged::FDelegate Delegate );
+
+	// Removes watcher and resets handle. Stale handles are ignored
+	void RemoveFactConditionWatcher( FFactWatcherHandle& Handle );
+
+	// @return last evaluated result of watched expression or false if handle is not valid
+	[[nodiscard]] bool GetFactConditionWatcherResult( const FFactWatcherHandle Handle ) const;
+
+	/**
+	 * Registers threshold listener, which is called when fact value rises to Threshold or above (bReached is true)
+	 * and when it drops below Threshold again (bReached is false), e.g. for achievements on counter facts.
+	 * Only thresholds, that were actually crossed, are found on change, so cost doesn't depend on number of registered thresholds.
+	 * Undefined fact is treated as 0. Listener is not called for initial value.
+	 * @return handle, that should be used for removing listener
+	 */
+	FFactThresholdHandle AddFactThresholdListener( const FFactTag Tag, int32 Threshold, FFactThresholdCrossed::FDelegate Delegate );
+	FFactThresholdHandle AddFactThresholdListener( const FFactHandle Handle, int32 Threshold, FFactThresholdCrossed::FDelegate Delegate );
+
+	// Removes threshold listener and resets handle. Stale handles are ignored
+	void RemoveFactThresholdListener( FFactThresholdHandle& Handle );
+
+	[[deprecated( "Use AddFactValueListener instead" )]] FFactChanged& GetOnFactValueChangedDelegate( FFactTag Tag );
+	[[deprecated( "Use AddFactDefinitionListener instead" )]] FFactChanged& GetOnFactBecameDefinedDelegate( FFactTag Tag );
+
+	/**
+	 * Journal of latest fact changes for consumers, that only care what was changed since they last looked (UI refresh, telemetry, autosave).
+	 * Capacity of journal is set by UFactSettings::ChangeJournalCapacity.
+	 * @param Sequence sequence of the last change, seen by caller (0 for the first call)
+	 * @param bOutOverflowed true if some changes after Sequence were already dropped, so caller should resync fully
+	 * @return changes with sequence greater than Sequence in order of their application. View is valid until any fact is changed
+	 */
+	[[nodiscard]] TConstArrayView< FFactChangeRecord > GetChangesSince( uint64 Sequence, bool& bOutOverflowed ) const;
+
+	// @return sequence of the latest fact change, 0 if nothing was changed yet
+	[[nodiscard]] uint64 GetLatestChangeSequence() const { return ChangeJournal.GetLatestSequence(); }
+
+	/**
+	 * Snapshot of all facts, that can be read from any thread without locks (e.g. by AI or streaming tasks).
+	 * New snapshot is published once per frame, if any fact was changed, so it can lag behind subsystem up to one frame.
+	 * Use PublishFactSnapshot, if workers need to see changes immediately.
+	 * Can be called from any thread, but workers, that can outlive subsystem, should hold GetFactSnapshotPublisher instead.
+	 * @return latest published snapshot
+	 */
+	[[nodiscard]] FFactSnapshotPtr GetFactSnapshot() const { return SnapshotPublisher->Acquire(); }
+	[[nodiscard]] TSharedRef< const FFactSnapshotPublisher, ESPMode::ThreadSafe > GetFactSnapshotPublisher() const { return SnapshotPublisher; }
+
+	// Publishes snapshot with current values right away. Only facts, changed since previous snapshot, are copied
+	void PublishFactSnapshot();
+
+	/**
+	 * Takes checkpoint of all facts (e.g. before retry or choice preview). Checkpoint shares storage with current snapshot,
+	 * so only facts, changed since previous snapshot, are copied. Accumulated increments of counter facts are folded first.
+	 */
+	[[nodiscard]] FFactCheckpoint TakeFactCheckpoint();
+
+	/**
+	 * Returns all facts to state of Checkpoint. Only parts of storage, that were changed since checkpoint was taken, are compared,
+	 * and listeners are notified (once per fact) only about facts, that were actually changed.
+	 * Increments of counter facts, that are not folded yet, are discarded, queued changes are applied later as usual.
+	 */
+	void RestoreFactCheckpoint( const FFactCheckpoint& Checkpoint );
+
+	/**
+	 * Sets immutable baseline layer of facts (e.g. chapter start) and replaces all facts with its values.
+	 * After that facts, changed by game, form sparse override layer on top of baseline: saves contain only overrides
+	 * and ResetFactsToBaseline returns them to baseline values. Null preset removes baseline (it is empty).
+	 * Listeners are notified only about facts, that were actually changed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
+	void SetFactBaseline( const UFactPreset* Preset );
+
+	/**
+	 * Returns all facts, that were changed since baseline was set (or facts were loaded), to their baseline values.
+	 * Cost depends only on number of overridden facts. Without baseline all facts become undefined.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
+	void ResetFactsToBaseline();
+
+	/**
+	 * Registers facts, whose values are computed from other facts and are recomputed (in dependency order, once per batch)
+	 * only when their sources change. Derived facts can be read and listened to like any other fact, but should not be changed directly.
+	 * Definitions from UFactSettings are registered on initialization.
+	 */
+	void RegisterDerivedFacts( TConstArrayView< FFactDerivedDefinition > Definitions );
 
 	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
-	void OnGameSaved( UFactSaveGame* SaveGame ) const;
+	void RegisterDerivedFactsAsset( const UFactDerivedFacts* Asset );
+
+	/**
+	 * Compiles rules into shared match network. Rules, whose conditions are already satisfied, fire right away.
+	 * Afterwards every fact change is propagated only through network nodes, that test the fact, and satisfied rules
+	 * are fired after listeners are notified. Rule sets from UFactSettings are registered on initialization.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
+	void RegisterFactRules( const UFactRules* Rules );
+
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
+	void UnregisterFactRules( const UFactRules* Rules );
+
+	/**
+	 * Writes all defined facts into SaveGame (only ones, that differ from baseline, if it is set). If UFactSettings::bIncrementalSaves is enabled and SaveGame is the same object,
+	 * that was saved or loaded last time, only facts, changed since then, are appended as delta record.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
+	void OnGameSaved( UFactSaveGame* SaveGame );
 	
+	/**
+	 * Replaces all facts with ones from SaveGame. Listeners are notified only about facts, that were actually changed,
+	 * after that OnFactsLoaded is broadcast with all changed tags.
+	 * Load is applied as one batch, so OnFactsBatchChanged is broadcast too (before OnFactsLoaded), if at least one fact was changed.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "FactSubsystem")
 	void OnGameLoaded( const UFactSaveGame* SaveGame );
 
+	/**
+	 * Asynchronous version of OnGameSaved. Takes snapshot of facts right away, then encodes it (always in compact format)
+	 * and compresses on worker thread. SaveGame is updated on game thread right before OnCompleted is executed,
+	 * so it should be written to slot only after that.
+	 */
+	void OnGameSavedAsync( UFactSaveGame* SaveGame, FFactSaveCompleted OnCompleted = {} );
+
+	/**
+	 * Asynchronous version of OnGameLoaded. Content of SaveGame is copied right away and decoded on worker thread,
+	 * then all decoded facts are applied on game thread in single step (right before OnCompleted is executed).
+	 */
+	void OnGameLoadedAsync( const UFactSaveGame* SaveGame, FFactLoadCompleted OnCompleted = {} );
+
 	FFactLoaded OnFactsLoaded;
+	FFactsBatchChanged OnFactsBatchChanged;
 
 private:
-	void BroadcastValueDelegate( const FFactTag Tag, int32 Value );
-	void BroadcastDefinitionDelegate( const FFactTag Tag, int32 Value );
+	enum class EFactWriteResult : uint8
+	{
+		Unchanged,
+		ValueChanged,
+		BecameDefined,
+		BecameUndefined
+	};
+
+	// Only modifies storage, listeners should be notified separately via NotifyFactChanged.
+	// Derived facts can be written only while they are recomputed, other writes to them are rejected with error
+	EFactWriteResult WriteFactValue( int32 Index, int32 NewValue, EFactValueChangeType ChangeType );
+
+	// Broadcasts delegates of changed fact or queues notification, if notifications are deferred
+	void NotifyFactChanged( int32 Index, EFactWriteResult Result );
+
+	// While notifications are deferred, they are collected (one per fact) and dispatched when last deferring ends
+	void BeginDeferNotifications();
+	void EndDeferNotifications();
+	void FlushPendingNotifications();
+
+	// Recomputes derived facts, whose sources were changed, as part of current batch of notifications
+	void UpdateDerivedFacts();
+
+	// Fires queued rule activations until queue is empty, respecting chain depth and cycle limits
+	void FireFactRules();
+
+	FFactListenerHandle AddFactListener( const FFactTag Tag, EFactListenerType Type, FFactChanged::FDelegate&& Delegate );
+	FFactChanged& GetFactDelegate( const FFactTag Tag, EFactListenerType Type );
+
+	void BroadcastValueDelegate( int32 Index, int32 Value );
+	void BroadcastDefinitionDelegate( int32 Index, int32 Value );
+	void BroadcastUndefinitionDelegate( int32 Index );
+
+	// Should be called for every change of single fact in storage, before storage is modified (value is nullptr if fact is undefined)
+	void RecordFactChange( int32 Index, const int32* OldValue, const int32* NewValue );
+
+	void SaveFactsIncrementally( UFactSaveGame* SaveGame );
+
+	// Starts building new base image of SaveGame (which should match current state of facts) from snapshot on worker thread
+	void StartSaveImage( UFactSaveGame* SaveGame, bool bCompact, bool bCompress, FFactSaveCompleted&& OnCompleted );
+	void FinishSaveImages();
+	void FinishLoads();
+
+	// Replaces all facts with loaded ones (on top of baseline of SaveGame) and notifies listeners about facts, that were actually changed
+	void ApplyLoadedFacts( FFactLoadResult&& LoadResult, const UFactSaveGame* SaveGame );
+
+	// Replaces all facts with NewFacts and notifies listeners about facts, that were actually changed (as one batch, so OnFactsBatchChanged is broadcast too).
+	// Only chunks, that differ from previous facts, are walked
+	void ReplaceAllFacts( FFactStorage&& NewFacts, TArray< FFactTag >* OutChangedTags );
+
+	// Writes state of single fact (NewValue is nullptr for undefined fact), which differs from OldValue, and notifies listeners
+	void ApplyFactState( int32 Index, const int32* OldValue, const int32* NewValue );
+
+	// Only sets baseline layer without changing facts
+	void SetBaselineLayer( const UFactPreset* Preset );
+
+	void MarkFactOverridden( int32 Index );
+	void ClearOverriddenFacts();
+
+	// Facts, that should be written into base image of save (besides all defined facts without baseline)
+	[[nodiscard]] TArray< int32 > GetSavedOverrides( const TMap< int32, int32 >& PendingCounters ) const;
+	[[nodiscard]] TMap< int32, int32 > GetPendingCounters() const;
+
+	bool Tick( float DeltaTime );
 	
 private:
+	// Values of all facts, indexed by FFactTagIndex
+	FFactStorage FactStorage;
+
+	// SaveGame layout of defined facts, that doesn't depend on order of tags in FFactTagIndex.
+	// Filled from FactStorage only while subsystem is serialized, empty otherwise
 	UPROPERTY(SaveGame)
 	TMap< FFactTag, int32 > DefinedFacts;
 
-	// maybe merge them together, some struct?
-	// also some form of map compaction
-	TMap< FFactTag, FFactChanged > ValueDelegates;
-	TMap< FFactTag, FFactChanged > DefinitionDelegates;
+	struct FPendingFactNotification
+	{
+		int32 Index;
+		bool bBecameDefined;
+	};
+
+	TArray< FPendingFactNotification > PendingNotifications;
+	// Facts, that already have pending notification, indexed by FFactTagIndex
+	TBitArray<> PendingFacts;
+	int32 DeferNotificationsCounter = 0;
+	bool bPendingBatchChanged = false;
+
+	struct FQueuedFactChange
+	{
+		// tag is resolved on game thread, if it was not registered at the moment of enqueueing
+		FFactTag Tag;
+		int32 Index;
+		int32 Value;
+		EFactValueChangeType ChangeType;
+	};
+
+	// Written from any thread, read only from game thread
+	TQueue< FQueuedFactChange, EQueueMode::Mpsc > QueuedChanges;
+
+	// Queued changes, merged per fact, and index of merged change for each fact (INDEX_NONE if there is none), used only while flushing queue
+	TArray< FQueuedFactChange > MergedChanges;
+	TArray< int32 > MergedChangeOfFact;
+
+	FFactChangeJournal ChangeJournal;
+
+	// Immutable baseline layer, shared with save workers. Null if there is no baseline
+	TSharedPtr< const FFactStorage, ESPMode::ThreadSafe > BaselineFacts;
+	FSoftObjectPath BaselinePreset;
+
+	// Override layer: facts, that could differ from baseline (changed since baseline was set or facts were loaded), indexed by FFactTagIndex.
+	// Values of overrides live in FactStorage together with baseline ones, so reads don't depend on layers
+	TBitArray<> OverriddenFacts;
+	TArray< int32 > OverriddenFactIndices;
+
+	// Facts, changed since last save or load, indexed by FFactTagIndex
+	TBitArray<> UnsavedFacts;
+	// Save game, that matches current state of facts, except of UnsavedFacts
+	TWeakObjectPtr< const UFactSaveGame > LastSaveGame;
+
+	struct FPendingSaveImage
+	{
+		// Builds new base image of save game (for async save or compaction)
+		UE::Tasks::TTask< FFactSaveImage > Task;
+		TWeakObjectPtr< UFactSaveGame > SaveGame;
+		// Number of first delta records, that are merged into new base image
+		int32 NumDeltas = 0;
+		FSoftObjectPath Baseline;
+		FFactSaveCompleted OnCompleted;
+	};
+	// Finished in order of starting, so the latest image wins
+	TArray< FPendingSaveImage > PendingSaveImages;
+
+	struct FPendingLoad
+	{
+		UE::Tasks::TTask< FFactLoadResult > Task;
+		TWeakObjectPtr< const UFactSaveGame > SaveGame;
+		FFactLoadCompleted OnCompleted;
+	};
+	TArray< FPendingLoad > PendingLoads;
+
+	// Accumulated increments of counter facts
+	FFactCounters Counters;
+	float CounterFoldInterval = 0.f;
+	float TimeSinceCounterFold = 0.f;
+
+	// Value and definition listeners of all facts
+	FFactListenerRegistry Listeners;
+
+	FFactConditionWatchers ConditionWatchers;
+
+	// Sorted thresholds of fact values
+	FFactThresholds Thresholds;
+
+	// Aggregates over every subtree of fact hierarchy
+	FFactAggregates Aggregates;
+
+	// Facts, computed from other facts
+	FFactDerivedGraph DerivedFacts;
+	bool bIsUpdatingDerivedFacts = false;
+
+	FFactRuleNetwork RuleNetwork;
+	bool bIsFiringRules = false;
+	// Set while all facts are replaced (loading, restoring checkpoint), so rules don't fire again for state, which they have produced already
+	bool bSuppressRuleActivations = false;
+
+	// Shared, so worker threads can keep acquiring snapshots even if subsystem is destroyed meanwhile
+	TSharedRef< FFactSnapshotPublisher, ESPMode::ThreadSafe > SnapshotPublisher = MakeShared< FFactSnapshotPublisher, ESPMode::ThreadSafe >();
+
+	FTSTicker::FDelegateHandle TickerHandle;
 
 #if !UE_BUILD_SHIPPING
 	static class FAutoConsoleCommandWithWorldAndArgs ChangeFactValueCommand;
 	static class FAutoConsoleCommandWithWorldAndArgs GetFactValueCommand;
 	static class FAutoConsoleCommandWithWorld		 DumpFactsCommand;
+	static class FAutoConsoleCommandWithWorldAndArgs GetFactsUnderTagCommand;
+	static class FAutoConsoleCommandWithWorldAndArgs ResetFactsUnderTagCommand;
+	static class FAutoConsoleCommandWithWorldAndArgs UndefineFactsUnderTagCommand;
 #endif
 };
+
+/**
+ * RAII helper for UFactSubsystem::BeginFactChangeScope/EndFactChangeScope.
+ * Listeners are notified only when the outermost scope is destroyed, so they never see half-applied state.
+ */
+class SIMPLEFACTS_API FFactChangeScope : public FNoncopyable
+{
+public:
+	explicit FFactChangeScope( UFactSubsystem& InFactSubsystem );
+	explicit FFactChangeScope( const UObject* WorldContextObject );
+	~FFactChangeScope();
+
+private:
+	TWeakObjectPtr< UFactSubsystem > FactSubsystem;
+};
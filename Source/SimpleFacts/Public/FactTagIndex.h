@@ -0,0 +1,101 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FactTypes.h"
+#include "Misc/ScopeRWLock.h"
+
+/**
+ * Process-wide mapping between fact tags and dense indices.
+ * Index is built once from "Fact" subtree of GameplayTagsManager (in depth-first order, so root "Fact" tag always has index 0).
+ * Tags, that are added later (e.g. in editor), are appended to the end. Tags are never removed, so once resolved index stays valid.
+ * Should be modified only from game thread. Find and FindByName are safe to call from any thread, other accessors - only from game thread.
+ * Index is created on first call of Get, which must happen on game thread (UFactSubsystem does it on initialization),
+ * so worker tasks should receive index from game thread instead of creating it.
+ */
+class SIMPLEFACTS_API FFactTagIndex
+{
+public:
+	[[nodiscard]] static FFactTagIndex& Get();
+
+	/**
+	 * Can be called from any thread.
+	 * @return index of fact tag or INDEX_NONE, if tag is not registered
+	 */
+	[[nodiscard]] int32 Find( const FGameplayTag Tag ) const;
+
+	/**
+	 * Same as Find, but registers valid fact tag, if it was added after index had been built.
+	 * @return index of fact tag or INDEX_NONE, if tag is not valid fact tag
+	 */
+	int32 FindOrAdd( const FGameplayTag Tag );
+
+	/**
+	 * Can be called from any thread, doesn't touch GameplayTagsManager, so saved names can be resolved on worker threads.
+	 * @return index of fact tag with given name (and tag itself in OutTag) or INDEX_NONE, if such tag is not registered
+	 */
+	[[nodiscard]] int32 FindByName( const FName TagName, FFactTag& OutTag ) const;
+
+	/**
+	 * Calls Func while index is locked for appending, so other accessors can be safely used inside it from any thread.
+	 * Blocks registration of new tags on game thread, so should not be held for long.
+	 */
+	template< typename FuncType >
+	void ReadLocked( FuncType&& Func ) const
+	{
+		FReadScopeLock ReadLock( Lock );
+		Func();
+	}
+
+	[[nodiscard]] FFactTag GetTag( int32 Index ) const { return Tags[ Index ]; }
+	[[nodiscard]] int32 GetParent( int32 Index ) const { return Parents[ Index ]; }
+	[[nodiscard]] int32 Num() const { return Tags.Num(); }
+	[[nodiscard]] bool IsValidIndex( int32 Index ) const { return Tags.IsValidIndex( Index ); }
+
+	/**
+	 * Indices of fact and all its descendants in depth-first order of tag tree, so subtree can be visited without checking every tag.
+	 * Order is rebuilt only after new tags are appended. View is valid until next tag is registered.
+	 */
+	[[nodiscard]] TConstArrayView< int32 > GetSubtree( int32 Index ) const;
+
+	/**
+	 * Signature of names of first NumTags tags in index order. Same in every process with the same tags,
+	 * so data with baked indices (e.g. cooked presets) can check, that its indices are still valid.
+	 */
+	[[nodiscard]] uint32 GetSignature( int32 NumTags ) const { return NumTags > 0 ? Signatures[ NumTags - 1 ] : 0; }
+
+private:
+	FFactTagIndex();
+
+	void AddNode( const TSharedPtr< struct FGameplayTagNode >& Node, int32 ParentIndex );
+	int32 AddTag( const FFactTag Tag, int32 ParentIndex );
+
+	void RebuildTreeOrder() const;
+	void AddToTreeOrder( int32 Index ) const;
+
+#if WITH_EDITOR
+	void HandleTagTreeRefreshed();
+#endif
+
+private:
+	TArray< FFactTag > Tags;
+	TArray< int32 > Parents;
+	// Signature of all tags up to and including the one with the same index
+	TArray< uint32 > Signatures;
+
+	// Children of each tag as linked list in order of registration
+	TArray< int32 > FirstChildren;
+	TArray< int32 > LastChildren;
+	TArray< int32 > NextSiblings;
+
+	// All indices in depth-first order, position of each index in it and size of its subtree. Built on first subtree query
+	mutable TArray< int32 > TreeOrder;
+	mutable TArray< int32 > TreePositions;
+	mutable TArray< int32 > SubtreeSizes;
+	TMap< FGameplayTag, int32 > TagToIndex;
+	TMap< FName, int32 > NameToIndex;
+
+	// Guards appending of tags against lookups from worker threads. Game thread is the only writer, so it reads without lock
+	mutable FRWLock Lock;
+};
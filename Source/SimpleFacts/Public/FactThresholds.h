@@ -0,0 +1,71 @@
+// Copyright 2024, Maksym Kapelianovych. Licensed under MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Executed when fact value crosses threshold: bReached is true when value rises to threshold or above, false when it drops below
+DECLARE_DELEGATE_OneParam( FFactThresholdCrossed, bool /*bReached*/ )
+
+// Handle to threshold, registered in FFactThresholds. Stale handles are safe to use
+struct SIMPLEFACTS_API FFactThresholdHandle
+{
+	[[nodiscard]] bool IsValid() const { return Id != 0; }
+	void Reset() { *this = FFactThresholdHandle(); }
+
+private:
+	friend class FFactThresholds;
+
+	int32 FactIndex = INDEX_NONE;
+	uint32 Id = 0;
+};
+
+/**
+ * Index of thresholds (e.g. achievements for 10, 50, 100 and 500 kills) over fact values.
+ * Thresholds of every fact are kept sorted, so when fact value changes, only thresholds, that were actually crossed,
+ * are found with binary search, regardless of how many thresholds are registered. Undefined fact is treated as 0.
+ */
+class SIMPLEFACTS_API FFactThresholds
+{
+public:
+	FFactThresholdHandle Add( int32 FactIndex, int32 Threshold, FFactThresholdCrossed::FDelegate&& Delegate );
+	void Remove( FFactThresholdHandle& Handle );
+
+	// Queues crossings of thresholds of the fact. Should be called for every change of fact value, so no crossing is missed
+	void OnFactChanged( int32 FactIndex, const int32* OldValue, const int32* NewValue );
+
+	// Executes delegates of queued crossings in order, in which they happened
+	void Dispatch();
+
+	[[nodiscard]] bool IsEmpty() const { return NumThresholds == 0; }
+
+private:
+	struct FThreshold
+	{
+		int32 Value = 0;
+		uint32 Id = 0;
+		FFactThresholdCrossed::FDelegate Delegate;
+	};
+
+	struct FCrossing
+	{
+		int32 FactIndex = INDEX_NONE;
+		int32 Value = 0;
+		uint32 Id = 0;
+		bool bReached = false;
+	};
+
+	[[nodiscard]] const FThreshold* Find( int32 FactIndex, int32 Value, uint32 Id ) const;
+
+	[[nodiscard]] const TArray< FThreshold >* FindThresholds( int32 FactIndex ) const
+	{
+		return ThresholdsByFact.IsValidIndex( FactIndex ) && ThresholdsByFact[ FactIndex ].Num() > 0 ? &ThresholdsByFact[ FactIndex ] : nullptr;
+	}
+
+private:
+	// Sorted by value, indexed by FFactTagIndex
+	TArray< TArray< FThreshold > > ThresholdsByFact;
+	int32 NumThresholds = 0;
+	TArray< FCrossing > PendingCrossings;
+	uint32 LastId = 0;
+};
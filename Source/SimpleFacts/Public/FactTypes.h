@@ -13,6 +13,38 @@ struct SIMPLEFACTS_API FFactTag : public FGameplayTag
 	END_TYPED_TAG_DECL( FFactTag, TEXT( "Fact" ) )
 };
 
+// Pre-resolved reference to a fact for native hot paths. Resolve it once from FFactTag and reuse,
+// so UFactSubsystem can access fact value directly, without tag validation and lookup
+struct SIMPLEFACTS_API FFactHandle
+{
+	FFactHandle() = default;
+
+	/**
+	 * @return handle to fact, or invalid handle if Tag is not valid fact tag
+	 */
+	[[nodiscard]] static FFactHandle Resolve( const FGameplayTag Tag );
+
+	/**
+	 * Same as Resolve, but never registers tags, so it can be called from any thread.
+	 * @return handle to fact, or invalid handle if Tag is not registered fact tag
+	 */
+	[[nodiscard]] static FFactHandle Find( const FGameplayTag Tag );
+
+	[[nodiscard]] bool IsValid() const { return Index != INDEX_NONE; }
+	[[nodiscard]] int32 GetIndex() const { return Index; }
+	[[nodiscard]] FFactTag GetTag() const;
+
+	bool operator==( const FFactHandle& Other ) const { return Index == Other.Index; }
+	bool operator!=( const FFactHandle& Other ) const { return Index != Other.Index; }
+
+	friend uint32 GetTypeHash( const FFactHandle& Handle ) { return ::GetTypeHash( Handle.Index ); }
+
+private:
+	explicit FFactHandle( int32 InIndex ) : Index( InIndex ) {}
+
+	int32 Index = INDEX_NONE;
+};
+
 UENUM(BlueprintType)
 enum class EFactCompareOperator : uint8
 {
@@ -26,7 +58,7 @@ enum class EFactCompareOperator : uint8
 	IsDefined UMETA(DisplayName = "defined")
 };
 
-UENUM()
+UENUM(BlueprintType)
 enum class EFactValueChangeType : uint8
 {
 	Set,
@@ -58,8 +90,70 @@ struct SIMPLEFACTS_API FFactCondition
 
 	bool IsValid() const;
 	FString ToString() const;
+
+	/**
+	 * Resolves handle of condition's fact. Handle is cached, so subsequent calls don't need any lookup
+	 * (cached handle is re-resolved only if Tag was changed).
+	 */
+	[[nodiscard]] FFactHandle GetHandle() const;
+
+	/**
+	 * Compares fact value with WantedValue using Operator.
+	 * @param FactValue pointer to value of defined fact or nullptr if fact is undefined
+	 */
+	[[nodiscard]] static bool Compare( const int32* FactValue, EFactCompareOperator Operator, int32 WantedValue )
+	{
+		switch ( Operator ) {
+		case EFactCompareOperator::Equals:
+			return FactValue && *FactValue == WantedValue;
+		case EFactCompareOperator::NotEquals:
+			return FactValue && *FactValue != WantedValue;
+		case EFactCompareOperator::Greater:
+			return FactValue && *FactValue > WantedValue;
+		case EFactCompareOperator::GreaterOrEqual:
+			return FactValue && *FactValue >= WantedValue;
+		case EFactCompareOperator::Less:
+			return FactValue && *FactValue < WantedValue;
+		case EFactCompareOperator::LessOrEqual:
+			return FactValue && *FactValue <= WantedValue;
+		case EFactCompareOperator::IsUndefined:
+			return FactValue == nullptr;
+		case EFactCompareOperator::IsDefined:
+			return FactValue != nullptr;
+		default:
+			checkf( false, TEXT( "Execution flow should not reach this line. There are some missing cases in switch statement" ) );
+		}
+
+		return false;
+	}
 	
 private:
 	
 	bool CheckValue( const UFactSubsystem& FactSubsystem ) const;
-};
\ No newline at end of file
+
+	mutable FFactHandle CachedHandle;
+};
+
+// Single change of fact value, used for applying several changes at once (see UFactSubsystem::ChangeFactValues)
+USTRUCT(BlueprintType)
+struct SIMPLEFACTS_API FFactChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fact")
+	FFactTag Tag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fact")
+	int32 Value = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fact")
+	EFactValueChangeType ChangeType = EFactValueChangeType::Set;
+
+	FFactChange() {}
+
+	FFactChange( FFactTag InTag, int32 InValue, EFactValueChangeType InChangeType = EFactValueChangeType::Set )
+		: Tag( InTag )
+		, Value( InValue )
+		, ChangeType( InChangeType )
+	{	}
+};
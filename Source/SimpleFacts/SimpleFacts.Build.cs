@@ -12,6 +12,7 @@ public class SimpleFacts : ModuleRules
 			new string[]
 			{
 				"Core",
+				"DeveloperSettings",
 				"TypedGameplayTags",
 			}
 			);
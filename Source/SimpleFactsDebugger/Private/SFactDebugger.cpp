@@ -60,7 +60,7 @@ FFactTreeItem::~FFactTreeItem()
 {
 	if ( UFactSubsystem* FactSubsystem = FSimpleFactsDebuggerModule::Get().TryGetFactSubsystem() )
 	{
-		FactSubsystem->GetOnFactValueChangedDelegate( Tag ).Remove( Handle );
+		FactSubsystem->RemoveFactListener( ListenerHandle );
 	}
 }
 
@@ -79,7 +79,7 @@ void FFactTreeItem::InitItem( bool bPlayAnimation )
 {
 	if ( UFactSubsystem* FactSubsystem = FSimpleFactsDebuggerModule::Get().TryGetFactSubsystem() )
 	{
-		Handle = FactSubsystem->GetOnFactValueChangedDelegate( Tag ).AddSP( this, &FFactTreeItem::HandleValueChanged );
+		ListenerHandle = FactSubsystem->AddFactValueListener( Tag, FFactChanged::FDelegate::CreateSP( this, &FFactTreeItem::HandleValueChanged ) );
 		
 		int32 FactValue;
 		if ( FactSubsystem->GetFactValueIfDefined( Tag, FactValue ) )
@@ -449,7 +449,7 @@ void SFactDebugger::HandleGameInstanceStarted()
 	
 	if ( UFactSubsystem* FactSubsystem = FSimpleFactsDebuggerModule::Get().TryGetFactSubsystem() )
 	{
-		FactsLoadedHandle = FactSubsystem->OnFactsLoaded.AddLambda( [ this ]()
+		FactsLoadedHandle = FactSubsystem->OnFactsLoaded.AddLambda( [ this ]( TConstArrayView< FFactTag > )
 		{
 			RebuildFactTreeItems( true );
 		} );
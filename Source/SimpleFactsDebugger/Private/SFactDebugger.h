@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "FactDebuggerSettingsLocal.h"
+#include "FactListenerRegistry.h"
 #include "FactTypes.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/STreeView.h"
@@ -37,7 +38,7 @@ struct FFactTreeItem : public TSharedFromThis< FFactTreeItem >
 
 	DECLARE_MULTICAST_DELEGATE_TwoParams( FOnFactItemValueChanged, FFactTag, int32 )
 	FOnFactItemValueChanged OnFactItemValueChanged;
-	FDelegateHandle Handle;
+	FFactListenerHandle ListenerHandle;
 };
 
 